@@ -1,10 +1,28 @@
 #ifndef AI_H
 #define AI_H
 
+#include "AI/Evaluator.h"
+#include "Core/Board.h"
+
 class AI
 {
+protected:
+	const Evaluator* m_evaluator; // optional, shared and not owned
+
 public:
+	AI();
+	virtual ~AI() {}
+
+	// Static
+	static AI* create(int level, int threadCount, int timeBudget);
+	static int getLevelGridSize(int level);
+	static int getLevelThreadCount(int level);
+	static int getLevelTimeBudget(int level);
+
 	virtual int getGridSize() = 0;
+	virtual int chooseMove(const Board& board);
+
+	virtual void setEvaluator(const Evaluator* evaluator);
 };
 
 #endif
@@ -2,11 +2,30 @@
 #define AI_HARD_H
 
 #include "AI.h"
+#include "Expectimax.h"
+#include "HeuristicEvaluator.h"
+#include "TranspositionTable.h"
+#include "Core/ThreadPool.h"
 
 class AI_Hard : public AI
 {
+private:
+	TranspositionTable m_table; // declared first, the search is built with it
+	HeuristicEvaluator m_heuristic; // values the leaves until another evaluator is shared
+	Expectimax m_search;
+	ThreadPool* m_pool;
+
 public:
+	AI_Hard();
+	AI_Hard(int threadCount);
+	AI_Hard(int threadCount, int timeBudget);
+	~AI_Hard();
+
 	int getGridSize();
+	int chooseMove(const Board& board);
+	void setEvaluator(const Evaluator* evaluator);
+
+	TranspositionTable* getTable();
 };
 
 #endif
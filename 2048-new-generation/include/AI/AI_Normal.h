@@ -2,11 +2,26 @@
 #define AI_NORMAL_H
 
 #include "AI.h"
+#include "MonteCarlo.h"
+#include "Core/ThreadPool.h"
 
 class AI_Normal: public AI
 {
+private:
+	MonteCarlo m_search;
+	ThreadPool* m_pool;
+
 public:
+	AI_Normal();
+	AI_Normal(int threadCount);
+	AI_Normal(int threadCount, int playoutCount, int timeBudget);
+	~AI_Normal();
+
 	int getGridSize();
+	int chooseMove(const Board& board);
+	void setEvaluator(const Evaluator* evaluator);
+
+	MonteCarlo* getSearch();
 };
 
 #endif
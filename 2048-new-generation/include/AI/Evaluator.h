@@ -0,0 +1,22 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "Core/Board.h"
+
+// Value the searches give to a game over, below any value of a living board whatever the weights of the evaluator
+const float GAME_OVER_VALUE = -1.0e30f;
+
+/**
+	Value of a board for the searches, the higher the better
+	Evaluators are only read while searching so a single one can be shared by every thread
+	A board is worth the same as its rotations and reflections, the searches cache the values of canonical boards
+*/
+class Evaluator
+{
+public:
+	virtual ~Evaluator() {}
+
+	virtual float evaluate(const Board& board) const = 0;
+};
+
+#endif
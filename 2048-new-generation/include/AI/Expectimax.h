@@ -0,0 +1,58 @@
+#ifndef EXPECTIMAX_H
+#define EXPECTIMAX_H
+
+#include "Core/Board.h"
+#include "AI/Evaluator.h"
+#include "AI/TranspositionTable.h"
+#include "Core/ThreadPool.h"
+
+#include <chrono>
+
+/**
+	Depth-limited expectimax search over the player moves and the random tile spawns
+	Iterative deepening keeps the best move of the last fully searched depth
+	so the search can be stopped as soon as its time budget is spent
+	Given a thread pool, the spawns following each root move are searched in parallel
+*/
+class Expectimax
+{
+private:
+	int m_maxDepth; // in player moves
+	int m_timeBudget; // in milliseconds
+	float m_minProbability;
+	TranspositionTable* m_table; // optional cache of the spawn nodes values, keyed by canonical board
+	ThreadPool* m_pool; // optional, the search is sequential without it
+	const Evaluator* m_evaluator; // values the leaves
+
+	// Search state
+	std::chrono::steady_clock::time_point m_deadline;
+	bool m_isTimeOut;
+	long long m_nodeCount;
+	int m_lastDepth;
+
+	// Searching
+	int searchRoot(const Board& board, int depth, float* bestValue);
+	int searchRootParallel(const Board& board, int depth, float* bestValue);
+	float searchMove(const Board& board, int depth, float probability);
+	float searchSpawn(const Board& board, int depth, float probability);
+	float evaluate(const Board& board);
+
+	// Querying
+	bool isTimeOut();
+
+public:
+	Expectimax(int maxDepth, int timeBudget, float minProbability, TranspositionTable* table);
+
+	// Actions
+	int chooseMove(const Board& board);
+
+	// Getters
+	long long getNodeCount();
+	int getLastDepth();
+
+	// Setters
+	void setThreadPool(ThreadPool* pool);
+	void setEvaluator(const Evaluator* evaluator);
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef HEURISTIC_EVALUATOR_H
+#define HEURISTIC_EVALUATOR_H
+
+#include "AI/Evaluator.h"
+
+#include <string>
+#include <vector>
+
+/**
+	Hand-made value of a board : empty cells, merges ready to be made, monotonic and smooth lines,
+	the biggest tile of a line at one of its ends, and a penalty for the tiles still on the board
+	Each of these only depends on a line, so a board is valued by the sum of its rows and columns,
+	each one a single lookup in a table computed for every possible packed row
+	Tables are computed once per grid size and weights, and shared by every evaluator using them
+*/
+class HeuristicEvaluator : public Evaluator
+{
+public:
+	struct Weights
+	{
+		float base; // every line starts with it
+		float empty;
+		float merges;
+		float monotonicity;
+		float monotonicityPower;
+		float smoothness;
+		float lineEnd;
+		float sum;
+		float sumPower;
+
+		Weights();
+	};
+
+private:
+	struct RowTable
+	{
+		int size;
+		Weights weights;
+		std::vector<float> rows; // value of every packed row, for rows and columns alike
+	};
+
+	int m_size;
+	Weights m_weights;
+	const float* m_rows; // shared, kept until the end of the program
+
+	// Static
+	static const float* getRowTable(int size, const Weights& weights);
+	static float evaluateLine(const int* line, int size, const Weights& weights);
+
+public:
+	HeuristicEvaluator(int size, const Weights& weights);
+
+	// Static
+	static bool loadWeights(const std::string& path, Weights* weights, std::string* error);
+
+	// Querying
+	float evaluate(const Board& board) const;
+
+	// Getters
+	const Weights& getWeights() const;
+};
+
+#endif
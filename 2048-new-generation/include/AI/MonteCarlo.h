@@ -0,0 +1,53 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include "AI/Evaluator.h"
+#include "Core/Board.h"
+#include "Core/Random.h"
+#include "Core/ThreadPool.h"
+
+#include <chrono>
+
+/**
+	Monte Carlo search : every possible move is followed by random playouts until the game is over,
+	the move with the best mean final score is chosen
+	Given an evaluator, playouts are cut after a few moves and their last board is evaluated instead
+	Playouts are split in fixed size batches, each with its own generator seeded from the board and the batch index,
+	so a search bounded by its playout count gives the same move on any number of threads
+	Given a thread pool, the batches are played in parallel
+*/
+class MonteCarlo
+{
+private:
+	int m_playoutCount; // per possible move
+	int m_timeBudget; // in milliseconds
+	ThreadPool* m_pool; // optional, the search is sequential without it
+	const Evaluator* m_evaluator; // optional, playouts go to the game over without it
+
+	// Search state
+	std::chrono::steady_clock::time_point m_deadline;
+	long long m_totalPlayoutCount;
+	long long m_totalMoveCount;
+
+	// Searching
+	float playout(Board board, Random& random, long long* moveCount);
+
+	// Querying
+	bool isTimeOut();
+
+public:
+	MonteCarlo(int playoutCount, int timeBudget);
+
+	// Actions
+	int chooseMove(const Board& board);
+
+	// Getters
+	long long getTotalPlayoutCount();
+	long long getTotalMoveCount();
+
+	// Setters
+	void setThreadPool(ThreadPool* pool);
+	void setEvaluator(const Evaluator* evaluator);
+};
+
+#endif
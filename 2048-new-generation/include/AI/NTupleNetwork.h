@@ -0,0 +1,57 @@
+#ifndef N_TUPLE_NETWORK_H
+#define N_TUPLE_NETWORK_H
+
+#include "AI/Evaluator.h"
+#include "AI/WeightFile.h"
+
+#include <string>
+#include <vector>
+
+/**
+	N-tuple network : the value of a board is the sum of the weights indexed by the exponents of a few fixed tuples of cells
+	Each tuple is sampled in the 8 symmetries of the board, so a board and its rotations or reflections share their weights
+	Weights are either mapped read-only from a weight file to play or owned to be trained
+*/
+class NTupleNetwork : public Evaluator
+{
+private:
+	int m_size;
+	int m_tupleCount;
+	std::vector<int> m_cells; // cell (y * size + x) of each tuple element, for each tuple and symmetry
+	size_t m_weightCount;
+	uint64_t m_layout; // hash of the tuples, so weights are never read with other tuples than their own
+
+	// Weights
+	std::vector<float> m_storage; // owned weights, with room to align them on a cache line
+	float* m_weights; // owned weights, null while mapped
+	const float* m_table; // the weights evaluations read, owned or mapped
+	WeightFile m_file;
+
+	// Setup/initialization
+	void initializeTuples();
+
+	// Querying
+	void loadCells(const Board& board, int* cells) const;
+	size_t getIndex(const int* cells, int tuple, int symmetry) const;
+
+public:
+	NTupleNetwork(int size);
+
+	// Actions
+	bool load(const std::string& path);
+	bool save(const std::string& path) const;
+	void makeWritable();
+	void update(const Board& board, float delta);
+
+	// Querying
+	float evaluate(const Board& board) const;
+	bool isLoaded() const;
+
+	// Getters
+	int getSize() const;
+	int getLookupCount() const;
+	size_t getWeightCount() const;
+	const std::string& getLoadError() const;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include "Core/Board.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// REPLACEMENT POLICIES
+const int TT_REPLACE_ALWAYS = 0; // the last stored board always wins
+const int TT_REPLACE_DEEPER = 1; // a board searched deeper is never replaced by a shallower one
+
+// Entries a board may be stored in, the 16-byte entries of a bucket share a cache line
+const int TT_BUCKET_SIZE = 4;
+
+/**
+	Fixed-size cache of the values computed by a search, indexed by a Zobrist hash of the board
+	The table holds a power of two number of entries grouped in buckets of TT_BUCKET_SIZE,
+	a board is stored in any entry of the bucket of its key and, once the bucket is full, replaces its shallowest entry
+	Each entry remembers how deep and at which probability its board has been searched
+	so a shallower result is never returned for a deeper request
+	The table is lock-free and can be shared by several searching threads
+*/
+class TranspositionTable
+{
+private:
+	struct Entry
+	{
+		std::atomic<uint64_t> check; // key ^ data, so a slot half-written or owned by another key is detected
+		std::atomic<uint64_t> data; // value, depth and probability packed together
+	};
+
+	// Counters are spread over several cache lines so threads do not fight over a single one
+	struct Counters
+	{
+		std::atomic<long long> hits;
+		std::atomic<long long> misses;
+		std::atomic<long long> collisions;
+		char padding[64 - 3 * sizeof(std::atomic<long long>)];
+	};
+
+	std::vector<Entry> m_entries;
+	size_t m_first; // index of the first entry on a cache line boundary, buckets start there
+	std::vector<Counters> m_counters;
+	uint64_t m_mask;
+	int m_policy;
+
+	Entry* getBucket(uint64_t key);
+	Counters& getCounters();
+
+	// Packing
+	static uint64_t pack(float value, int depth, float probability);
+	static float unpackValue(uint64_t data);
+	static int unpackDepth(uint64_t data);
+	static int unpackProbability(uint64_t data);
+	static int quantizeProbability(float probability);
+
+	// Hashing
+	static const uint64_t* getZobristKeys();
+
+public:
+	TranspositionTable(int sizeLog2, int policy);
+
+	// Static
+	static uint64_t hash(const Board& board);
+
+	// Actions
+	bool probe(uint64_t key, int depth, float probability, float* value);
+	void store(uint64_t key, int depth, float probability, float value);
+	void clear();
+	void resetCounters();
+
+	// Getters
+	long long getHits();
+	long long getMisses();
+	long long getCollisions();
+	size_t getCapacity();
+	size_t getMemorySize(); // in bytes
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef WEIGHT_FILE_H
+#define WEIGHT_FILE_H
+
+#include "Core/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// VERSION
+const uint32_t WEIGHT_FILE_VERSION = 1; // to raise whenever the layout of the file or of a kind of evaluator changes
+
+// KINDS OF EVALUATOR
+const uint32_t WEIGHT_KIND_NTUPLE = 1;
+
+/**
+	Binary file of the weights of an evaluator, mapped read-only and used in place
+	A fixed header describes the weights : it is checked against what the evaluator expects
+	so a file of another version, machine, evaluator or grid is refused instead of being misread
+	The weights follow at a page boundary, so every table the evaluator indexes stays aligned on cache lines
+	Pages are only read once touched, and processes using the same file share them
+*/
+class WeightFile
+{
+public:
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder; // reads BYTE_ORDER_MARK on a machine of the same endianness
+		uint32_t kind;
+		uint32_t gridSize;
+		uint64_t layout; // hash of how the evaluator indexes its weights
+		uint64_t weightCount; // 32-bit floats
+		uint64_t dataOffset; // in bytes from the start of the file
+		uint64_t reserved;
+	};
+
+private:
+	MappedFile m_file;
+	const float* m_weights;
+	std::string m_error;
+
+	// Querying
+	bool check(const Header& header, const Header& expected, size_t fileSize);
+
+public:
+	WeightFile();
+
+	// Static
+	static Header createHeader(uint32_t kind, uint32_t gridSize, uint64_t layout, uint64_t weightCount);
+	static bool write(const std::string& path, const Header& header, const float* weights);
+
+	// Actions
+	bool open(const std::string& path, const Header& expected);
+	void close();
+
+	// Getters
+	const float* getWeights() const;
+	const std::string& getError() const;
+};
+
+#endif
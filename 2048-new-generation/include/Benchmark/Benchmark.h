@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "Core/Board.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+	Measure the cost of the game core kernels (move, spawn and game over check) for each grid size
+	Kernels run over a corpus of boards taken from seeded random games, so two runs with the same seed
+	measure exactly the same work
+	Percentiles are taken over small batches of boards, timed one by one
+*/
+class Benchmark
+{
+private:
+	struct Stats
+	{
+		double mean; // in nanoseconds per operation
+		double min; // over the batches
+		double p50;
+		double p90;
+		double p99;
+	};
+
+	uint64_t m_seed;
+	int m_boardCount;
+	int m_sampleCount;
+	volatile uint64_t m_sink; // keeps the kernels results alive so they are not optimized away
+
+	// Setup/initialization
+	std::vector<Board> buildCorpus(int size);
+
+	// Actions
+	Stats measure(int opsPerBoard, const std::function<uint64_t(size_t, size_t)>& kernel);
+	void report(const char* name, int size, const Stats& stats);
+
+public:
+	Benchmark(uint64_t seed, int boardCount, int sampleCount);
+
+	// Actions
+	void run();
+};
+
+#endif
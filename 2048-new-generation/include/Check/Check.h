@@ -0,0 +1,74 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include "AI/Evaluator.h"
+#include "AI/WeightFile.h"
+#include "Core/Board.h"
+#include "Core/Game.h"
+#include "Core/Random.h"
+
+#include <string>
+#include <vector>
+
+/**
+	Headless checks of the game core kernels against plain cell by cell references
+	Boards are drawn from a seeded generator so a failing check can be replayed
+*/
+class Check
+{
+private:
+	// A board as a plain array of exponents, the cell (x, y) at y * size + x
+	struct Cells
+	{
+		int size;
+		int exponents[GRID_SIZE_MAX * GRID_SIZE_MAX];
+	};
+
+	// Values the crowded boards the most, as an evaluator may value a dead board like a crowded living one
+	struct TileCountEvaluator : public Evaluator
+	{
+		float evaluate(const Board& board) const { return (float)board.countTiles(); }
+	};
+
+	Random m_random;
+	int m_boardCount;
+	int m_checkCount;
+	int m_failureCount;
+
+	// Setup/initialization
+	Cells drawCells(int size, int maxExponent);
+	static Board toBoard(const Cells& cells);
+	static std::vector<char> toBytes(const WeightFile::Header& header, const std::vector<float>& weights);
+	static bool writeBytes(const std::string& path, const std::vector<char>& bytes);
+
+	// References
+	static int slideReference(Cells* cells, int dir);
+	static Cells symmetryReference(const Cells& cells, int symmetry);
+
+	// Games
+	static Game playHardGame(uint64_t seed, int moveCount);
+
+	// Actions
+	void expect(bool condition, const std::string& what);
+	void checkRandom();
+	void checkBoard();
+	void checkMoves();
+	void checkGameOver();
+	void checkTranspositionTable();
+	void checkSymmetries();
+	void checkSymmetricValues(const Evaluator& evaluator, const std::vector<Cells>& boards, const std::string& name);
+	void checkEvaluators();
+	void checkWeightFile();
+	void checkHardGame();
+	void checkSearches();
+	void checkSelectBit();
+	void checkSpawns();
+
+public:
+	Check(uint64_t seed, int boardCount);
+
+	// Actions
+	bool run();
+};
+
+#endif
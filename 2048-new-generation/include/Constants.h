@@ -2,31 +2,29 @@
 #define CONSTANTS_H
 
 #include <SFML/Graphics.hpp>
-
-// VALUES
-const int GHOST_VAL = -1;
-
-// DIRECTIONS INPUT
-const int DIR_LEFT = 0;
-const int DIR_RIGHT = 1;
-const int DIR_UP = 2;
-const int DIR_DOWN = 3;
-const int DIR_NONE = -1;
+#include "Core/GameConstants.h"
 
 // SCREEN DIMENSION
 const int SCREEN_W = 1920;
 const int SCREEN_H = 1080;
 
-// GRID SIZES
-const int SIZE_AI_EASY = 3;
-const int SIZE_AI_NORMAL = 4;
-const int SIZE_AI_HARD = 5;
-const int GRID_EDGE_WIDTH = 3;
+// MAIN LOOP POLICIES
+const int LOOP_FIXED = 0; // capped to a fixed framerate
+const int LOOP_VSYNC = 1; // synced with the screen refresh
+const int LOOP_EVENT = 2; // asleep until an event comes, redrawn only on change
+const unsigned int LOOP_FRAMERATE = 60U;
+
+// ANIMATION
+const int ANIMATION_DURATION = 100; // time a move takes on screen, in milliseconds
+
+// INPUT
+const int INPUT_BUFFER_SIZE = 4; // moves that can be typed ahead of the board
 
 // AI
-const int AI_EASY = 0;
-const int AI_NORMAL = 1;
-const int AI_HARD = 2;
+const std::string HEURISTIC_CONFIG_PATH = "assets/config/heuristic.cfg"; // relative to the working directory, as the font
+
+// GRID
+const int GRID_EDGE_WIDTH = 3;
 
 // TILES COLORS
 const sf::Color TILE_COLOR_2 = sf::Color(255, 250, 265);
@@ -40,6 +38,7 @@ const sf::Color TILE_COLOR_256 = sf::Color(219, 151, 4);
 const sf::Color TILE_COLOR_512 = sf::Color(255, 161, 84);
 const sf::Color TILE_COLOR_1024 = sf::Color(255, 128, 25);
 const sf::Color TILE_COLOR_2048 = sf::Color(255, 25, 25);
+const sf::Color TILE_COLOR_BEYOND = sf::Color(60, 58, 50); // 4096 and above
 const sf::Color TILE_COLOR_GHOST = sf::Color(219, 219, 219);
 
 // TILES TEXT STRINGS
@@ -49,6 +48,8 @@ const std::string TEXT_STRING_GHOST = " ";
 const unsigned int TEXT_SIZE_STD = 60U; // for 1 and 2-digit numbers 
 const unsigned int TEXT_SIZE_3DIGIT = 50U;
 const unsigned int TEXT_SIZE_4DIGIT = 35U;
+const unsigned int TEXT_SIZE_5DIGIT = 28U;
 const unsigned int TEXT_SIZE_GHOST = 0U;
+const unsigned int TEXT_ATLAS_SIZE = TEXT_SIZE_STD; // glyphs are rasterized once at this size and scaled down
 
 #endif
\ No newline at end of file
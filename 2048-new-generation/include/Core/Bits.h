@@ -0,0 +1,94 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// pdep is only worth it where it is implemented in hardware, which AVX2 builds can rely on
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define BITS_HAS_PDEP
+#endif
+
+/**
+	Portable wrappers around the bit counting intrinsics
+*/
+inline int popCount(uint32_t x)
+{
+#ifdef _MSC_VER
+	return (int)__popcnt(x);
+#else
+	return __builtin_popcount(x);
+#endif
+}
+
+inline int popCount(uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return (int)__popcnt64(x);
+#elif defined(_MSC_VER)
+	return (int)(__popcnt((uint32_t)x) + __popcnt((uint32_t)(x >> 32)));
+#else
+	return __builtin_popcountll(x);
+#endif
+}
+
+inline int countTrailingZeros(uint32_t x)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return (int)index;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+/**
+	Get the position of the k-th set bit of a mask, counting from the lowest one, without pdep
+
+	@param mask The mask, holding more than k set bits
+	@param k The rank of the bit, from 0
+	@return The position of the bit
+*/
+inline int selectBitPortable(uint32_t mask, int k)
+{
+	// Skip whole bytes first, then the lower bits of the right byte
+	int shift = 0;
+	int count = popCount(mask & 0xFFU);
+
+	while (count <= k) {
+		k -= count;
+		shift += 8;
+		count = popCount((mask >> shift) & 0xFFU);
+	}
+
+	mask >>= shift;
+
+	for (; k > 0; k--) {
+		mask &= mask - 1;
+	}
+
+	return shift + countTrailingZeros(mask);
+}
+
+/**
+	Get the position of the k-th set bit of a mask, counting from the lowest one
+
+	@param mask The mask, holding more than k set bits
+	@param k The rank of the bit, from 0
+	@return The position of the bit
+*/
+inline int selectBit(uint32_t mask, int k)
+{
+#ifdef BITS_HAS_PDEP
+	return countTrailingZeros(_pdep_u32(1U << k, mask));
+#else
+	return selectBitPortable(mask, k);
+#endif
+}
+
+#endif
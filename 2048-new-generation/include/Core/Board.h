@@ -0,0 +1,170 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "Core/GameConstants.h"
+
+#include <cstdint>
+
+/**
+	Packed value-type representation of the game state
+	Each cell stores the log2 exponent of its tile value on 4 bits (0 standing for an empty cell)
+	Rows are packed one after the other, each one on (4 * size) bits :
+	the 3x3 and 4x4 boards fit in the first word, the 5x5 board spills its last two rows into the second one
+*/
+class Board
+{
+private:
+	uint64_t m_words[2];
+	int m_size; // in cells per line
+
+	int getRowsPerWord() const;
+	int getWordIndex(int y) const;
+	int getRowShift(int y) const;
+	uint32_t getRowMask() const;
+	static uint32_t getZeroCells(uint32_t row);
+	void unpackRows(uint32_t* rows) const;
+	void packRows(const uint32_t* rows);
+
+public:
+	Board();
+	Board(int size);
+
+	// Static
+	static int toExponent(int value);
+	static int toValue(int exponent);
+
+	// Actions
+	bool move(int dir);
+	bool move(int dir, int* score);
+	Board transpose() const;
+	Board flipHorizontal() const;
+	Board flipVertical() const;
+	Board canonicalize() const;
+
+	// Querying
+	int countEmpty() const;
+	uint32_t getEmptyMask() const;
+	int countTiles() const;
+	int getMaxExponent() const;
+	bool isEmpty(int x, int y) const;
+	bool hasAnyMove() const;
+
+	// Getters
+	int getSize() const;
+	int getExponent(int x, int y) const;
+	int getValue(int x, int y) const;
+	uint32_t getRow(int y) const;
+	uint64_t getWord(int index) const;
+
+	// Setters
+	void setExponent(int x, int y, int exponent);
+	void setValue(int x, int y, int value);
+	void setRow(int y, uint32_t row);
+
+	bool operator==(const Board& other) const;
+	bool operator!=(const Board& other) const;
+
+	// Debug
+	void __toString() const;
+};
+
+/**
+	Accessors below are on every game logic hot path so they are kept inline
+*/
+inline int Board::getRowsPerWord() const
+{
+	static const int ROWS_PER_WORD[GRID_SIZE_MAX + 1] = { 1, 1, 8, 5, 4, 3 };
+
+	return ROWS_PER_WORD[m_size];
+}
+
+inline int Board::getWordIndex(int y) const
+{
+	return y < getRowsPerWord() ? 0 : 1;
+}
+
+inline int Board::getRowShift(int y) const
+{
+	int row = y < getRowsPerWord() ? y : y - getRowsPerWord();
+
+	return row * 4 * m_size;
+}
+
+inline uint32_t Board::getRowMask() const
+{
+	return (1U << (4 * m_size)) - 1U;
+}
+
+/**
+	Read every row at once, the word and shift of each row following from the previous one
+
+	@param rows Where to store the size rows
+*/
+inline void Board::unpackRows(uint32_t* rows) const
+{
+	int perWord = getRowsPerWord();
+	int width = 4 * m_size;
+	uint32_t mask = getRowMask();
+
+	for (int y = 0; y < m_size; y++) {
+		int word = y < perWord ? 0 : 1;
+
+		rows[y] = (uint32_t)(m_words[word] >> ((y - word * perWord) * width)) & mask;
+	}
+}
+
+/**
+	Write every row at once over the whole board
+
+	@param rows The size rows
+*/
+inline void Board::packRows(const uint32_t* rows)
+{
+	int perWord = getRowsPerWord();
+	int width = 4 * m_size;
+
+	m_words[0] = 0;
+	m_words[1] = 0;
+
+	for (int y = 0; y < m_size; y++) {
+		int word = y < perWord ? 0 : 1;
+
+		m_words[word] |= (uint64_t)rows[y] << ((y - word * perWord) * width);
+	}
+}
+
+inline uint32_t Board::getRow(int y) const
+{
+	return (uint32_t)(m_words[getWordIndex(y)] >> getRowShift(y)) & getRowMask();
+}
+
+inline void Board::setRow(int y, uint32_t row)
+{
+	uint64_t& word = m_words[getWordIndex(y)];
+	int shift = getRowShift(y);
+
+	word &= ~((uint64_t)getRowMask() << shift);
+	word |= (uint64_t)(row & getRowMask()) << shift;
+}
+
+inline int Board::getExponent(int x, int y) const
+{
+	return (int)(getRow(y) >> (4 * x)) & 0xF;
+}
+
+inline void Board::setExponent(int x, int y, int exponent)
+{
+	uint32_t row = getRow(y);
+
+	row &= ~(0xFU << (4 * x));
+	row |= (uint32_t)(exponent & 0xF) << (4 * x);
+
+	setRow(y, row);
+}
+
+inline int Board::getSize() const
+{
+	return m_size;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "Core/Board.h"
+#include "Core/Random.h"
+
+/**
+	A whole game without any rendering : the board, its score and the turn rules
+	Used by the grid to play on screen and by the simulations to play headless
+*/
+class Game
+{
+private:
+	Board m_board;
+	Random m_random; // own generator so games can run concurrently and be replayed from their seed
+	int m_score;
+	int m_moveCount;
+
+	// Game over cache, only computed again once the board has changed
+	bool m_isMovePossible;
+	bool m_isMovePossibleValid;
+
+	// Actions
+	int getRandomValue();
+	void invalidateMovePossible();
+
+public:
+	Game(int size, uint64_t seed);
+
+	// Actions
+	void start();
+	bool move(int dir);
+	bool play(int dir);
+	int spawnTile();
+
+	// Querying
+	bool isMovePossible();
+
+	// Getters
+	const Board& getBoard() const;
+	int getScore() const;
+	int getMoveCount() const;
+	int getMaxTile() const;
+	uint64_t getSeed() const;
+
+	// Setters
+	void setBoard(const Board& board);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef GAME_CONSTANTS_H
+#define GAME_CONSTANTS_H
+
+// VALUES
+const int GHOST_VAL = -1;
+const int EMPTY_EXPONENT = 0;
+const int MAX_EXPONENT = 15; // a cell is stored on 4 bits
+
+// SPAWNS
+const double TILE_FOUR_PROBABILITY = 0.5; // a new tile is a 4 with this probability, a 2 otherwise
+
+// DIRECTIONS INPUT
+const int DIR_LEFT = 0;
+const int DIR_RIGHT = 1;
+const int DIR_UP = 2;
+const int DIR_DOWN = 3;
+const int DIR_NONE = -1;
+const int DIR_COUNT = 4;
+
+// GRID SIZES
+const int SIZE_AI_EASY = 3;
+const int SIZE_AI_NORMAL = 4;
+const int SIZE_AI_HARD = 5;
+const int GRID_SIZE_MIN = SIZE_AI_EASY;
+const int GRID_SIZE_MAX = SIZE_AI_HARD;
+
+// AI
+const int AI_EASY = 0;
+const int AI_NORMAL = 1;
+const int AI_HARD = 2;
+
+// AI MONTE CARLO
+const int AI_NORMAL_PLAYOUT_COUNT = 200; // per possible move
+const int AI_NORMAL_TIME_BUDGET = 0; // in milliseconds per move, 0 to always play every playout
+const int AI_NORMAL_BATCH_SIZE = 25; // playouts per task, each with its own generator
+const int AI_NORMAL_THREAD_COUNT = 0; // 0 for every hardware thread
+const int AI_NORMAL_PLAYOUT_DEPTH = 20; // in moves, before a playout is cut and evaluated when an evaluator is shared
+
+// AI N-TUPLE NETWORK
+const int NTUPLE_LENGTH = 6; // cells per tuple, 16^6 weights each
+const int NTUPLE_SYMMETRY_COUNT = 8; // rotations and reflections of the board
+const int NTUPLE_MAX_COUNT = 4; // tuples per network
+
+// AI SEARCH
+const int AI_HARD_MAX_DEPTH = 8; // in player moves
+const int AI_HARD_TIME_BUDGET = 15; // in milliseconds per move, 0 to always reach the max depth
+const float AI_HARD_MIN_PROBABILITY = 0.0001f; // less likely spawn branches are evaluated directly
+const int AI_HARD_TABLE_SIZE_LOG2 = 20; // 2^20 entries of 16 bytes, 16 MB
+const int AI_HARD_THREAD_COUNT = 0; // 0 for every hardware thread, 1 with no time budget for a reproducible search
+
+#endif
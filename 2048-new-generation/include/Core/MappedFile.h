@@ -0,0 +1,44 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+	A whole file mapped read-only in memory
+	Pages are only read from the disk once touched, and processes mapping the same file share them
+*/
+class MappedFile
+{
+private:
+	const void* m_data;
+	size_t m_size; // in bytes
+#ifdef _WIN32
+	void* m_file;
+	void* m_mapping;
+#else
+	int m_file;
+#endif
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	// Actions
+	bool open(const std::string& path);
+	void close();
+	void swap(MappedFile& other);
+	void adviseRandomAccess();
+
+	// Querying
+	bool isOpen() const;
+
+	// Getters
+	const void* getData() const;
+	size_t getSize() const;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef MOVE_TABLE_H
+#define MOVE_TABLE_H
+
+#include "Core/GameConstants.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+	Precomputed result of sliding every possible packed row of a given size
+	A row of n cells is encoded on 4n bits so the table holds 16^n entries :
+	4096 for the 3x3 grid, 65536 for the 4x4 one and 1048576 for the 5x5 one
+	Each entry packs both slides and the score on 64 bits, so the 4x4 table fits in 512 KB
+	Tables are built once, the first time a size is requested
+*/
+class MoveTable
+{
+private:
+	MoveTable(int size);
+
+	// Entry layout : the row slid left on 20 bits, slid right on the next 20, then the score on 24
+	static const int RIGHT_SHIFT = 20;
+	static const int SCORE_SHIFT = 40;
+	static const uint64_t ROW_MASK = 0xFFFFF;
+
+	static std::atomic<const MoveTable*> s_tables[GRID_SIZE_MAX + 1]; // set once each table is built
+
+	std::vector<uint64_t> m_rows;
+	int m_size;
+
+	// Setup/initialization
+	void initializeRows();
+	static const MoveTable& build(int size);
+
+public:
+	// Static
+	static const MoveTable& get(int size);
+	static int slideLine(int* line, int size, int* targets);
+
+	// Querying
+	uint32_t slideLeft(uint32_t row) const;
+	uint32_t slideRight(uint32_t row) const;
+	uint32_t slide(uint32_t row, bool isReversed) const;
+	uint32_t getScore(uint32_t row) const;
+
+	// Getters
+	int getSize() const;
+};
+
+/**
+	Get the table of the provided size, building it on first use
+	Once built, a table is a single load away so moves can look it up every time
+
+	@param size The number of cells per row (SIZE_AI_EASY, SIZE_AI_NORMAL or SIZE_AI_HARD)
+	@return The move table
+*/
+inline const MoveTable& MoveTable::get(int size)
+{
+	const MoveTable* table = s_tables[size].load(std::memory_order_acquire);
+
+	return table ? *table : build(size);
+}
+
+inline uint32_t MoveTable::slideLeft(uint32_t row) const
+{
+	return (uint32_t)(m_rows[row] & ROW_MASK);
+}
+
+inline uint32_t MoveTable::slideRight(uint32_t row) const
+{
+	return (uint32_t)((m_rows[row] >> RIGHT_SHIFT) & ROW_MASK);
+}
+
+/**
+	@param row The packed row
+	@param isReversed If the tiles slide towards the last cell rather than the first one
+	@return The slid row
+*/
+inline uint32_t MoveTable::slide(uint32_t row, bool isReversed) const
+{
+	return (uint32_t)((m_rows[row] >> (isReversed ? RIGHT_SHIFT : 0)) & ROW_MASK);
+}
+
+inline uint32_t MoveTable::getScore(uint32_t row) const
+{
+	return (uint32_t)(m_rows[row] >> SCORE_SHIFT);
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef MOVE_TRACE_H
+#define MOVE_TRACE_H
+
+#include "Core/Board.h"
+
+#include <vector>
+
+/**
+	Where each tile of a board goes during a move, for whoever has to show the move rather than play it
+	The packed move tables only give the resulting board, so each line is slid again here
+	by the same function the tables are built with, which also tells where each tile goes
+*/
+class MoveTrace
+{
+public:
+	struct Motion
+	{
+		int fromX;
+		int fromY;
+		int toX;
+		int toY;
+		int exponent; // of the tile before the move
+		bool isMerged; // if the tile merges into the one already at its destination
+	};
+
+private:
+	std::vector<Motion> m_motions;
+
+	// Setup/initialization
+	void traceLine(const Board& board, int dir, int line);
+
+public:
+	MoveTrace(const Board& board, int dir);
+
+	// Getters
+	const std::vector<Motion>& getMotions() const;
+};
+
+#endif
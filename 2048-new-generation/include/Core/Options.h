@@ -0,0 +1,29 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+	The command line options, given as "--name value", "--name=value" or as a "--flag"
+*/
+class Options
+{
+private:
+	std::map<std::string, std::string> m_values;
+
+public:
+	Options(int argc, char** argv);
+
+	// Querying
+	bool has(const std::string& name) const;
+
+	// Getters
+	std::string getString(const std::string& name, const std::string& fallback) const;
+	int getInt(const std::string& name, int fallback) const;
+	uint64_t getUInt64(const std::string& name, uint64_t fallback) const;
+	float getFloat(const std::string& name, float fallback) const;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+	xoshiro256** generator : fast, small and statistically sound, with no hidden global state
+	Its whole state derives from a single 64-bit seed so any game can be replayed from its seed
+*/
+class Random
+{
+private:
+	uint64_t m_state[4];
+	uint64_t m_seed;
+
+	static uint64_t rotateLeft(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	Random(uint64_t seed);
+
+	// Static
+	static uint64_t splitMix(uint64_t& state);
+	static uint64_t createSeed();
+
+	// Actions
+	int nextInt(int bound);
+	bool nextBool(double probability);
+
+	/**
+		Get the next 64 random bits
+
+		@return The random bits
+	*/
+	uint64_t next()
+	{
+		uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+		uint64_t t = m_state[1] << 17;
+
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= t;
+		m_state[3] = rotateLeft(m_state[3], 45);
+
+		return result;
+	}
+
+	// Getters
+	uint64_t getSeed() const;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+	Fixed set of worker threads sharing tasks through work stealing
+	Each worker owns a queue : it takes its own tasks from the back and steals the others' from the front
+	so uneven tasks end up balanced across the workers
+	A pool of a single thread has no worker at all and runs everything in order on the calling thread
+*/
+class ThreadPool
+{
+private:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::thread> m_threads;
+	std::vector<Queue*> m_queues; // one per worker, plus one for the threads calling the pool
+	std::mutex m_mutex;
+	std::condition_variable m_wakeUp;
+	std::atomic<int> m_queuedCount;
+	bool m_isStopping;
+
+	// Actions
+	void push(int queueIndex, std::function<void()> task);
+	bool pop(int queueIndex, std::function<void()>& task);
+	void workerLoop(int queueIndex);
+
+public:
+	ThreadPool(int threadCount);
+	~ThreadPool();
+
+	// Static
+	static int getHardwareThreadCount();
+
+	// Actions
+	void parallelFor(int count, const std::function<void(int)>& body);
+
+	// Getters
+	int getThreadCount();
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include "Entities/Grid.h"
+#include "Core/Random.h"
 
 using namespace sf;
 
@@ -11,11 +12,38 @@ class Engine
 private:
 	RenderWindow m_window;
 	Grid* m_grid;
-	std::vector<int> dirDataBuffer;
-	bool wasActionKeyPressed = false;
+	Random m_random; // for the session's own needs, the game has its own generator
+	bool isAutoPlay = false; // if the grid's AI is playing
 
-	bool isMoveKeyPressed();
-	bool isActionKeyPressed();
+	// Input, moves are queued as key events come and played one per turn
+	struct MoveCommand
+	{
+		int dir;
+		Time time; // when the key event has been read
+	};
+
+	std::vector<MoveCommand> dirDataBuffer; // ring buffer
+	int dirDataHead = 0;
+	int dirDataCount = 0;
+	Clock m_clock;
+
+	// Latency from a key event to the board update
+	int m_latencyCount = 0;
+	Time m_latencyTotal;
+	Time m_latencyMax;
+
+	// Main loop
+	int m_loopPolicy;
+	bool m_needsRedraw = true; // if the window content is out of date
+	Clock m_frameClock; // time elapsed between two updates
+
+	void setupLoop(unsigned int framerate);
+	void processEvents(bool isBlocking);
+	void handleEvent(const Event& event);
+
+	void pushMove(int dir);
+	void playMove(const MoveCommand& command);
+	void reportLatency();
 
 	void screenshot();
 	long uniqueID();
@@ -26,7 +54,10 @@ private:
 	void draw();
 
 public:
-	Engine();
+	Engine(uint64_t seed, int loopPolicy, unsigned int framerate, int animationDuration, const std::string& heuristicPath);
+
+	// Static
+	static int parseLoopPolicy(const std::string& name);
 
 	void start();
 };
@@ -0,0 +1,44 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "Core/MoveTrace.h"
+
+#include <SFML/System.hpp>
+#include <vector>
+
+using namespace sf;
+
+/**
+	Slide of the tiles of the last move, only shown on screen
+	The game state is already up to date when the animation starts, so it never slows the game down :
+	a new move simply replaces the animation of the previous one
+*/
+class Animation
+{
+private:
+	std::vector<MoveTrace::Motion> m_motions;
+	Time m_duration;
+	Time m_elapsed;
+	bool m_isRunning;
+	bool m_isFirstFrame; // the time elapsed before the move started is not part of the animation
+
+public:
+	Animation();
+
+	// Actions
+	void start(const MoveTrace& trace);
+	bool update(Time dt);
+	void stop();
+
+	// Querying
+	bool isRunning();
+
+	// Getters
+	float getProgress();
+	const std::vector<MoveTrace::Motion>& getMotions();
+
+	// Setters
+	void setDuration(Time duration);
+};
+
+#endif
@@ -2,7 +2,11 @@
 #define GRID_H
 
 #include "Entities/Tile.h"
+#include "Entities/TileAtlas.h"
+#include "Entities/Animation.h"
+#include "Core/Game.h"
 #include "AI/AI.h"
+#include "AI/HeuristicEvaluator.h"
 
 #include <SFML/Graphics.hpp>
 
@@ -13,83 +17,80 @@ class Tile;
 class Grid
 {
 private:
-	Grid(int AI);
+	Grid(int AI, uint64_t seed);
 	static Grid* self;
 
 	// Attributes
-	std::vector<std::vector<Tile*>> m_tiles;
+	Game* m_game; // the game state, tiles are only a view of its board used for drawing
+	std::vector<Tile> m_tiles; // pool of size * size tiles allocated once, the cell (x, y) at y * size + x
 	AI* m_AI;
+	HeuristicEvaluator* m_heuristic = nullptr; // weighted by a config file, shared with the AI
 	int m_size; // in tiles per line
 	float m_size_pix; // in pixels
 	int m_dir;
 	RectangleShape m_shape;
-
-	bool doMerge;
+	VertexArray m_quads; // the grid's background, drawn in one call
+	VertexArray m_faces; // the tiles, drawn in one call from the atlas
+	bool m_isBatchDirty = true; // if a tile has changed since the vertex arrays have been built
+	Animation m_animation; // the last move as shown on screen
+	uint32_t m_newTiles = 0; // cells spawned at the end of the last turn, one bit per cell
 
 	// Ressources
-	Font* m_font;
-
-	// TEST context variables
-	std::vector<int> directions = std::vector<int>(4);
-	bool _isMovePossible = false;
-	bool _isTest = false;
+	Font* m_font = nullptr;
+	TileAtlas* m_atlas = nullptr; // pre-rendered tile faces for this grid's tile size
 
 	// Setup/initialization
 	void setupAI(int AI);
-	void setupSize();
+	void setupSize(uint64_t seed);
 	void setupSizePix();
 	void setupShape();
 	void centerShape();
 	void setupFont();
-	void initializeDirections();
+	void setupAtlas();
 	void initializeTiles();
 	void setupTilesStates();
-
-	// Actions
-	void move(int x, int y);
-	void mergeTiles(int current_x, int current_y, Tile* t);
-	int getRandomIndex();
-	void resetTestVariables();
+	void buildVertices();
+	void buildAnimationVertices();
 
 	// Querying
-	bool isRoomAvailable();
-	bool canMove(Tile* currentTile);
-	bool isThereANeighbour(Tile *neighbourTile);
-	bool isThereAnEdge(Vector2f* pos);
+	bool isNewTile(int x, int y);
 
 public:
 	// Static
-	static Grid* createGrid(int AI);
-	static int getRandomValue();
+	static Grid* createGrid(int AI, uint64_t seed);
 
 	// Actions
+	bool loadHeuristic(const std::string& path);
 	void refreshTiles();
 	void newTile();
 	void moveLeft();
 	void moveRight();
 	void moveUp();
 	void moveDown();
-	void moveTiles();
+	bool moveTiles();
+	bool playAI();
 	void unnewTiles();
 
 	// Querying
 	int count();
 	bool isMovePossible();
+	bool isAnimating();
 
 	// Getters
 	Font* getFont();
+	TileAtlas* getAtlas();
 	float getTileSize();
 	RectangleShape* getShape();
 	int getSize();
+	int getScore();
 	Tile* getTile(int x, int y);
+	const Board& getBoard();
 
 	// Setters
-	void setTile(int x, int y, Tile* tile);
-	void removeTile(int x, int y);
-	void turnOnTest();
+	void setAnimationDuration(Time duration);
 
 	// Engine
-	void update();
+	bool update(Time dt);
 	void draw(RenderWindow* w);
 
 	// Debug
@@ -0,0 +1,27 @@
+#ifndef QUAD_H
+#define QUAD_H
+
+#include <SFML/Graphics.hpp>
+
+/**
+	Helpers to batch rectangles into a single quads vertex array, so a whole batch is one draw call
+*/
+inline void appendQuad(sf::VertexArray& array, const sf::FloatRect& rect, const sf::Color& color, const sf::FloatRect& texRect)
+{
+	float right = rect.left + rect.width;
+	float bottom = rect.top + rect.height;
+	float texRight = texRect.left + texRect.width;
+	float texBottom = texRect.top + texRect.height;
+
+	array.append(sf::Vertex(sf::Vector2f(rect.left, rect.top), color, sf::Vector2f(texRect.left, texRect.top)));
+	array.append(sf::Vertex(sf::Vector2f(right, rect.top), color, sf::Vector2f(texRight, texRect.top)));
+	array.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(texRight, texBottom)));
+	array.append(sf::Vertex(sf::Vector2f(rect.left, bottom), color, sf::Vector2f(texRect.left, texBottom)));
+}
+
+inline void appendQuad(sf::VertexArray& array, const sf::FloatRect& rect, const sf::Color& color)
+{
+	appendQuad(array, rect, color, sf::FloatRect());
+}
+
+#endif
@@ -13,37 +13,22 @@ class Grid;
 class Tile
 {
 private:
-	Tile(int v, int x, int y, Grid* g);
 	int m_value;
-	Vector2f m_position;
+	Vector2f m_position; // top left corner, on screen
 	Vector2f m_index;
-	RectangleShape m_shape;
+	FloatRect m_face; // texture coordinates of the tile's face in the grid's atlas
 	Grid* m_grid;
-	Text m_text;
-	
+
 	bool m_isGhost;
-	bool m_isNew; // if the tile is created for the new turn
-	bool m_isNewlyCreated; // if the tile is resulting of a merge (FOR THE CURRENT TURN !!)
-	
-	void setupShape();
-	void setupText();
-	void updateText();
-	void setupOrigins();
+	bool m_isNewlyCreated; // if the tile has been spawned at the end of the last turn
+
+	bool m_isDirty; // only changed tiles are updated
+
 	void setupPosition(int x, int y);
-	void setupShapePosition();
-	void setupTextPosition();
-	void setupTileColor();
-	unsigned int getTextSize();
+	void setupFace();
 
 public:
-	static Tile* createRandom(int x, int y, Grid* g);
-	static Tile* createGhost(int x, int y, Grid* g);
-	
-	void moveLeft();
-	void moveRight();
-	void moveUp();
-	void moveDown();
-	void refresh();
+	Tile(int x, int y, Grid* g);
 
 	Vector2f getPosition();
 	Vector2f getIndex();
@@ -54,23 +39,13 @@ public:
 	int getValue();
 	std::string getTextString();
 	bool isGhost();
-	bool isNew();
 	bool isNewlyCreated();
-	bool isMergeable(Tile* targetTile);
 
-	void setIndex(Vector2f index);
-	void setIndex(int x, int y);
-	void setX(int x);
-	void setY(int y);
-	void setPosX(float posX);
-	void setPosY(float posY);
-	void setGhost(bool isGhost);
-	void setNew(bool isNew);
+	void setValue(int value); // mirror the value of the board cell
 	void setNewlyCreated(bool isNewlyCreated);
-	void up(); // set value and text
 
-	void update();
-	void draw(RenderWindow* w);
+	bool update();
+	void batch(VertexArray& faces);
 
 	void __toString();
 };
@@ -0,0 +1,41 @@
+#ifndef TILE_ATLAS_H
+#define TILE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+using namespace sf;
+
+/**
+	Cache of pre-rendered tile faces (background colour and number) for a single tile size
+	Each face is rendered once into a shared texture the first time it is asked for,
+	so tiles are drawn as plain textured quads and faces never reached cost nothing
+*/
+class TileAtlas
+{
+private:
+	const Font* m_font;
+	unsigned int m_tileSize; // in pixels
+	RenderTexture* m_texture; // created along with the first face
+	std::vector<bool> m_isRendered; // one slot per exponent and per text colour
+
+	int getSlot(int value, bool isNewlyCreated);
+	FloatRect getSlotRect(int slot);
+	void renderFace(int slot, int value, bool isNewlyCreated);
+	void layoutText(VertexArray& glyphs, int value, bool isNewlyCreated, const FloatRect& rect);
+
+public:
+	TileAtlas(const Font* font, unsigned int tileSize);
+	~TileAtlas();
+
+	// Static
+	static Color getFaceColor(int value);
+	static unsigned int getTextSize(int value);
+
+	// Getters
+	FloatRect getFace(int value, bool isNewlyCreated);
+	const Texture& getTexture();
+	unsigned int getTileSize();
+};
+
+#endif
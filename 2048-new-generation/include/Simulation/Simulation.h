@@ -0,0 +1,67 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "AI/AI.h"
+#include "AI/Evaluator.h"
+#include "Core/Options.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+	Play games with an AI as fast as possible, without any window, font or text,
+	then report the scores and the speed of the games
+	Games are spread across a thread pool, one game per task with its own AI and its own seed
+*/
+class Simulation
+{
+private:
+	struct GameResult
+	{
+		int score;
+		int maxTile;
+		int moveCount;
+		long long tableHits;
+		long long tableProbes;
+		long long tableCollisions;
+		long long playoutCount;
+		long long playoutMoveCount;
+	};
+
+	int m_level;
+	int m_gameCount;
+	int m_threadCount;
+	uint64_t m_seed;
+	int m_moveLimit; // per game, 0 to play until no move is possible
+	int m_timeBudget; // per move of the AI in milliseconds, 0 to always search the whole depth
+	Evaluator* m_evaluator; // optional, shared by the AI of every game
+
+	// Results, one slot per game so no task ever writes where another one does
+	std::vector<GameResult> m_results;
+	double m_seconds;
+
+	// Actions
+	GameResult playGame(int index);
+
+public:
+	Simulation(int level, int gameCount, int threadCount, uint64_t seed);
+	~Simulation();
+
+	// Static
+	static int parseLevel(const std::string& name);
+	static uint64_t getGameSeed(uint64_t seed, int index);
+	static int runFromOptions(const Options& options);
+
+	// Actions
+	bool loadWeights(const std::string& path);
+	bool loadHeuristic(const std::string& path);
+	void run();
+	void report();
+
+	// Setters
+	void setMoveLimit(int moveLimit);
+	void setTimeBudget(int timeBudget);
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef TRAINING_H
+#define TRAINING_H
+
+#include "AI/NTupleNetwork.h"
+#include "Core/Board.h"
+#include "Core/Game.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+	Learn the weights of an n-tuple network from self-play by temporal difference
+	The network values the boards right after a move, before the new tile : each game is played greedily
+	on the score of a move plus the value of the board it leads to, then every board of the game
+	is moved towards its lambda-return, from the last one to the first one (TD(0) with a lambda of 0)
+*/
+class Training
+{
+private:
+	NTupleNetwork* m_network;
+	float m_rate; // shared between the weights of a board
+	float m_lambda;
+	uint64_t m_seed;
+
+	// The boards of the current game after each move, and the score of each move
+	std::vector<Board> m_afterstates;
+	std::vector<int> m_rewards;
+
+	// Actions
+	void playGame(Game& game);
+	void learnGame();
+	int chooseMove(const Board& board);
+
+public:
+	Training(NTupleNetwork* network, float rate, float lambda, uint64_t seed);
+
+	// Actions
+	void run(int gameCount, int reportInterval, const std::string& output);
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "AI/AI.h"
+#include "AI/AI_Easy.h"
+#include "AI/AI_Normal.h"
+#include "AI/AI_Hard.h"
+
+AI::AI()
+{
+	m_evaluator = nullptr;
+}
+
+/**
+	Instantiate the AI of the provided level
+
+	@param level AI_EASY, AI_NORMAL or AI_HARD
+	@param threadCount The number of threads an AI may search with (0 for every hardware thread)
+	@param timeBudget The time an AI may search each move for, in milliseconds (0 for no limit)
+		A single thread without time budget makes every level reproducible
+	@return The new AI
+*/
+AI* AI::create(int level, int threadCount, int timeBudget)
+{
+	switch (level) {
+	case AI_EASY:
+		return new AI_Easy();
+	case AI_NORMAL:
+		return new AI_Normal(threadCount, AI_NORMAL_PLAYOUT_COUNT, timeBudget);
+	default:
+		return new AI_Hard(threadCount, timeBudget);
+	}
+}
+
+/**
+	Get the size of the grid an AI level plays on, without creating the AI
+
+	@param level AI_EASY, AI_NORMAL or AI_HARD
+	@return The size of the grid
+*/
+int AI::getLevelGridSize(int level)
+{
+	switch (level) {
+	case AI_EASY:
+		return SIZE_AI_EASY;
+	case AI_NORMAL:
+		return SIZE_AI_NORMAL;
+	default:
+		return SIZE_AI_HARD;
+	}
+}
+
+/**
+	Get the number of threads an AI level searches with when it plays on its own, as in the window
+
+	@param level AI_EASY, AI_NORMAL or AI_HARD
+	@return The number of threads (0 for every hardware thread)
+*/
+int AI::getLevelThreadCount(int level)
+{
+	switch (level) {
+	case AI_EASY:
+		return 1;
+	case AI_NORMAL:
+		return AI_NORMAL_THREAD_COUNT;
+	default:
+		return AI_HARD_THREAD_COUNT;
+	}
+}
+
+/**
+	Get the time an AI level searches each move for when it plays on its own, as in the window
+
+	@param level AI_EASY, AI_NORMAL or AI_HARD
+	@return The time budget, in milliseconds (0 for no limit)
+*/
+int AI::getLevelTimeBudget(int level)
+{
+	switch (level) {
+	case AI_EASY:
+		return 0;
+	case AI_NORMAL:
+		return AI_NORMAL_TIME_BUDGET;
+	default:
+		return AI_HARD_TIME_BUDGET;
+	}
+}
+
+/**
+	Default strategy : greedily pick the move gaining the most points
+	Ties are broken by keeping the most empty cells
+	With an evaluator, the points are added to the value of the board the move leads to
+
+	@param board The current state of the game
+	@return The chosen direction, DIR_NONE if no move is possible
+*/
+int AI::chooseMove(const Board& board)
+{
+	int bestDir = DIR_NONE;
+	float bestValue = -1.0f;
+	int bestEmpty = -1;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+		int score = 0;
+
+		if (!next.move(dir, &score)) {
+			continue;
+		}
+
+		float value = m_evaluator ? score + m_evaluator->evaluate(next) : (float)score;
+		int empty = next.countEmpty();
+
+		if (bestDir == DIR_NONE || value > bestValue || (value == bestValue && empty > bestEmpty)) {
+			bestDir = dir;
+			bestValue = value;
+			bestEmpty = empty;
+		}
+	}
+
+	return bestDir;
+}
+
+/**
+	Share an evaluator with the AI, its searches value the boards with it instead of their own heuristic
+
+	@param evaluator The evaluator, null for the AI's own heuristic
+*/
+void AI::setEvaluator(const Evaluator* evaluator)
+{
+	m_evaluator = evaluator;
+}
@@ -1,5 +1,5 @@
 #include "pch.h"
-#include "Constants.h"
+#include "Core/GameConstants.h"
 #include "AI/AI_Easy.h"
 
 int AI_Easy::getGridSize()
@@ -1,8 +1,63 @@
 #include "pch.h"
-#include "Constants.h"
+#include "Core/GameConstants.h"
 #include "AI/AI_Hard.h"
 
+AI_Hard::AI_Hard()
+	: AI_Hard(AI_HARD_THREAD_COUNT)
+{
+}
+
+/**
+	@param threadCount The number of threads searching each move (0 for every hardware thread)
+*/
+AI_Hard::AI_Hard(int threadCount)
+	: AI_Hard(threadCount, AI_HARD_TIME_BUDGET)
+{
+}
+
+/**
+	@param threadCount The number of threads searching each move (0 for every hardware thread)
+	@param timeBudget The time allowed to choose a move, in milliseconds (0 to always reach AI_HARD_MAX_DEPTH)
+		With a single thread and no time budget, the same board always gives the same move
+*/
+AI_Hard::AI_Hard(int threadCount, int timeBudget)
+	: m_table(AI_HARD_TABLE_SIZE_LOG2, TT_REPLACE_DEEPER),
+	m_heuristic(SIZE_AI_HARD, HeuristicEvaluator::Weights()),
+	m_search(AI_HARD_MAX_DEPTH, timeBudget, AI_HARD_MIN_PROBABILITY, &m_table)
+{
+	m_pool = new ThreadPool(threadCount);
+	m_search.setThreadPool(m_pool);
+	m_search.setEvaluator(&m_heuristic);
+}
+
+AI_Hard::~AI_Hard()
+{
+	delete m_pool;
+}
+
 int AI_Hard::getGridSize()
 {
 	return SIZE_AI_HARD;
 }
+
+int AI_Hard::chooseMove(const Board& board)
+{
+	return m_search.chooseMove(board);
+}
+
+/**
+	Evaluate the leaves of the search with an evaluator
+
+	@param evaluator The evaluator, null for the heuristic with its default weights
+*/
+void AI_Hard::setEvaluator(const Evaluator* evaluator)
+{
+	AI::setEvaluator(evaluator);
+	m_search.setEvaluator(evaluator ? evaluator : &m_heuristic);
+	m_table.clear();
+}
+
+TranspositionTable* AI_Hard::getTable()
+{
+	return &m_table;
+}
@@ -1,8 +1,59 @@
 #include "pch.h"
-#include "Constants.h"
+#include "Core/GameConstants.h"
 #include "AI/AI_Normal.h"
 
+AI_Normal::AI_Normal()
+	: AI_Normal(AI_NORMAL_THREAD_COUNT)
+{
+}
+
+/**
+	@param threadCount The number of threads playing the playouts of each move (0 for every hardware thread)
+*/
+AI_Normal::AI_Normal(int threadCount)
+	: AI_Normal(threadCount, AI_NORMAL_PLAYOUT_COUNT, AI_NORMAL_TIME_BUDGET)
+{
+}
+
+/**
+	@param threadCount The number of threads playing the playouts of each move (0 for every hardware thread)
+	@param playoutCount The number of playouts following each possible move
+	@param timeBudget The time allowed to choose a move, in milliseconds (0 for no limit)
+*/
+AI_Normal::AI_Normal(int threadCount, int playoutCount, int timeBudget)
+	: m_search(playoutCount, timeBudget)
+{
+	m_pool = new ThreadPool(threadCount);
+	m_search.setThreadPool(m_pool);
+}
+
+AI_Normal::~AI_Normal()
+{
+	delete m_pool;
+}
+
 int AI_Normal::getGridSize()
 {
 	return SIZE_AI_NORMAL;
 }
+
+int AI_Normal::chooseMove(const Board& board)
+{
+	return m_search.chooseMove(board);
+}
+
+/**
+	Cut the playouts of the search and evaluate their last board with an evaluator
+
+	@param evaluator The evaluator, null to play every playout to the game over
+*/
+void AI_Normal::setEvaluator(const Evaluator* evaluator)
+{
+	AI::setEvaluator(evaluator);
+	m_search.setEvaluator(evaluator);
+}
+
+MonteCarlo* AI_Normal::getSearch()
+{
+	return &m_search;
+}
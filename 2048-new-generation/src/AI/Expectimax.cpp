@@ -0,0 +1,374 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "AI/Expectimax.h"
+
+#include <vector>
+
+/**
+	@param maxDepth The deepest search, in player moves
+	@param timeBudget The time allowed to choose a move, in milliseconds (0 to always reach maxDepth, which keeps a sequential search reproducible)
+	@param minProbability Spawn branches less likely than this are evaluated instead of searched
+	@param table The cache of the spawn nodes values, can be null
+*/
+Expectimax::Expectimax(int maxDepth, int timeBudget, float minProbability, TranspositionTable* table)
+{
+	m_maxDepth = maxDepth;
+	m_timeBudget = timeBudget;
+	m_minProbability = minProbability;
+	m_table = table;
+	m_pool = nullptr;
+	m_evaluator = nullptr;
+	m_isTimeOut = false;
+	m_nodeCount = 0;
+	m_lastDepth = 0;
+}
+
+/**
+	Search deeper and deeper until the maximum depth or the time budget is reached
+	The first depth is always completed so a move is returned whatever the budget
+
+	@param board The current state of the game
+	@return The best direction found, DIR_NONE if no move is possible
+*/
+int Expectimax::chooseMove(const Board& board)
+{
+	m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_timeBudget);
+	m_isTimeOut = false;
+	m_nodeCount = 0;
+	m_lastDepth = 0;
+
+	int bestDir = DIR_NONE;
+
+	for (int depth = 1; depth <= m_maxDepth; depth++) {
+		float value;
+		int dir = (m_pool && m_pool->getThreadCount() > 1) ?
+			searchRootParallel(board, depth, &value) : searchRoot(board, depth, &value);
+
+		// The depth has not been fully searched so its result can not be trusted
+		if (m_isTimeOut) {
+			break;
+		}
+
+		bestDir = dir;
+		m_lastDepth = depth;
+
+		// No move is possible, searching deeper will not change anything
+		if (dir == DIR_NONE) {
+			break;
+		}
+	}
+
+	return bestDir;
+}
+
+/**
+	Search each possible player move from the root
+
+	@param board The current state of the game
+	@param depth The number of player moves to search
+	@param bestValue Where to store the expected value of the best move
+	@return The best direction, DIR_NONE if no move is possible
+*/
+int Expectimax::searchRoot(const Board& board, int depth, float* bestValue)
+{
+	int bestDir = DIR_NONE;
+
+	*bestValue = 0.0f;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+
+		if (!next.move(dir)) {
+			continue;
+		}
+
+		float value = searchSpawn(next, depth, 1.0f);
+
+		if (m_isTimeOut) {
+			return DIR_NONE;
+		}
+
+		if (bestDir == DIR_NONE || value > *bestValue) {
+			bestDir = dir;
+			*bestValue = value;
+		}
+	}
+
+	return bestDir;
+}
+
+/**
+	Search each possible player move from the root, spreading the spawns that follow them across the pool
+	Each task searches one spawn on its own copy of the search state, only the table is shared
+
+	@param board The current state of the game
+	@param depth The number of player moves to search
+	@param bestValue Where to store the expected value of the best move
+	@return The best direction, DIR_NONE if no move is possible
+*/
+int Expectimax::searchRootParallel(const Board& board, int depth, float* bestValue)
+{
+	struct SpawnTask
+	{
+		int dir;
+		Board board;
+		float probability; // weight of the spawn in the expected value of its move
+		float value;
+		long long nodeCount;
+		bool isTimeOut;
+	};
+
+	float spawnProbabilities[2] = { (float)(1.0 - TILE_FOUR_PROBABILITY), (float)TILE_FOUR_PROBABILITY };
+	std::vector<SpawnTask> tasks;
+	bool isPossible[DIR_COUNT] = { false };
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+
+		if (!next.move(dir)) {
+			continue;
+		}
+
+		isPossible[dir] = true;
+
+		int size = next.getSize();
+		int empty = next.countEmpty();
+
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				if (!next.isEmpty(x, y)) {
+					continue;
+				}
+
+				for (int i = 0; i < 2; i++) {
+					SpawnTask task;
+					task.dir = dir;
+					task.board = next;
+					task.board.setExponent(x, y, i + 1);
+					task.probability = spawnProbabilities[i] / empty;
+					tasks.push_back(task);
+				}
+			}
+		}
+	}
+
+	m_pool->parallelFor((int)tasks.size(), [this, &tasks, depth](int i) {
+		Expectimax worker = *this;
+		worker.m_nodeCount = 0;
+
+		// Small tasks may never reach a clock check of their own
+		worker.m_isTimeOut = m_timeBudget > 0 && m_lastDepth > 0 && std::chrono::steady_clock::now() >= m_deadline;
+		tasks[i].value = worker.m_isTimeOut ?
+			0.0f : worker.searchMove(tasks[i].board, depth - 1, tasks[i].probability);
+		tasks[i].nodeCount = worker.m_nodeCount;
+		tasks[i].isTimeOut = worker.m_isTimeOut;
+	});
+
+	float values[DIR_COUNT] = { 0.0f };
+
+	for (size_t i = 0; i < tasks.size(); i++) {
+		values[tasks[i].dir] += tasks[i].probability * tasks[i].value;
+		m_nodeCount += tasks[i].nodeCount;
+
+		if (tasks[i].isTimeOut) {
+			m_isTimeOut = true;
+		}
+	}
+
+	if (m_isTimeOut) {
+		return DIR_NONE;
+	}
+
+	int bestDir = DIR_NONE;
+
+	*bestValue = 0.0f;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		if (isPossible[dir] && (bestDir == DIR_NONE || values[dir] > *bestValue)) {
+			bestDir = dir;
+			*bestValue = values[dir];
+		}
+	}
+
+	return bestDir;
+}
+
+/**
+	Max node : the player picks the move with the best expected value
+
+	@param board The board after the last spawn
+	@param depth The number of player moves left to search
+	@param probability The probability to reach this node
+	@return The expected value of the node, GAME_OVER_VALUE for a game over
+*/
+float Expectimax::searchMove(const Board& board, int depth, float probability)
+{
+	++m_nodeCount;
+
+	if (isTimeOut()) {
+		return 0.0f;
+	}
+
+	if (depth == 0) {
+		return evaluate(board);
+	}
+
+	float best = GAME_OVER_VALUE;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+
+		if (!next.move(dir)) {
+			continue;
+		}
+
+		float value = searchSpawn(next, depth, probability);
+
+		if (value > best) {
+			best = value;
+		}
+	}
+
+	return best;
+}
+
+/**
+	Chance node : a 2 or a 4 spawns uniformly on one of the empty cells
+
+	@param board The board after the player move
+	@param depth The number of player moves left to search, including this one
+	@param probability The probability to reach this node
+	@return The expected value of the node
+*/
+float Expectimax::searchSpawn(const Board& board, int depth, float probability)
+{
+	++m_nodeCount;
+
+	if (isTimeOut()) {
+		return 0.0f;
+	}
+
+	int empty = board.countEmpty();
+
+	if (empty == 0) {
+		return searchMove(board, depth - 1, probability);
+	}
+
+	float cellProbability = probability / empty;
+
+	if (cellProbability < m_minProbability) {
+		return evaluate(board);
+	}
+
+	// The same board is often reached through different move and spawn orders,
+	// keyed by its canonical board it also shares its entry with its rotations and reflections
+	uint64_t key = 0;
+	float cached;
+
+	if (m_table) {
+		key = TranspositionTable::hash(board.canonicalize());
+
+		if (m_table->probe(key, depth, probability, &cached)) {
+			return cached;
+		}
+	}
+
+	float twoProbability = (float)(1.0 - TILE_FOUR_PROBABILITY);
+	float fourProbability = (float)TILE_FOUR_PROBABILITY;
+	float sum = 0.0f;
+	int size = board.getSize();
+
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			if (!board.isEmpty(x, y)) {
+				continue;
+			}
+
+			Board two = board;
+			two.setExponent(x, y, 1);
+			sum += twoProbability * searchMove(two, depth - 1, cellProbability * twoProbability);
+
+			Board four = board;
+			four.setExponent(x, y, 2);
+			sum += fourProbability * searchMove(four, depth - 1, cellProbability * fourProbability);
+		}
+	}
+
+	float value = sum / empty;
+
+	// A value computed after the time out is incomplete
+	if (m_table && !m_isTimeOut) {
+		m_table->store(key, depth, probability, value);
+	}
+
+	return value;
+}
+
+/**
+	Value of a leaf, evaluators may value a living board below 0 so a game over is valued GAME_OVER_VALUE instead
+	Leaves at the end of the depth are often full boards, and the evaluator may value a dead one like a crowded living one
+
+	@param board The board to evaluate
+	@return The value of the board, GAME_OVER_VALUE for a game over
+*/
+float Expectimax::evaluate(const Board& board)
+{
+	return board.hasAnyMove() ? m_evaluator->evaluate(board) : GAME_OVER_VALUE;
+}
+
+/**
+	Check if the time budget has been spent
+	The clock is only read every few thousand nodes, and never during the first depth
+	or when the search has no time budget
+
+	@return If the search has to stop
+*/
+bool Expectimax::isTimeOut()
+{
+	if (!m_isTimeOut && m_timeBudget > 0 && m_lastDepth > 0 && (m_nodeCount & 0xFFF) == 0) {
+		m_isTimeOut = std::chrono::steady_clock::now() >= m_deadline;
+	}
+
+	return m_isTimeOut;
+}
+
+/**
+	Get the number of nodes visited by the last search
+
+	@return The number of nodes
+*/
+long long Expectimax::getNodeCount()
+{
+	return m_nodeCount;
+}
+
+/**
+	Share a thread pool with the search, null to search sequentially
+	A sequential search is fully reproducible, a parallel one may vary with the threads timing
+
+	@param pool The thread pool
+*/
+void Expectimax::setThreadPool(ThreadPool* pool)
+{
+	m_pool = pool;
+}
+
+/**
+	Share the evaluator valuing the leaves of the search, it has to be set before searching
+
+	@param evaluator The evaluator
+*/
+void Expectimax::setEvaluator(const Evaluator* evaluator)
+{
+	m_evaluator = evaluator;
+}
+
+/**
+	Get the deepest depth fully searched by the last search
+
+	@return The depth, in player moves
+*/
+int Expectimax::getLastDepth()
+{
+	return m_lastDepth;
+}
@@ -0,0 +1,261 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "AI/HeuristicEvaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+/**
+	Default weights, tuned on 4x4 games
+*/
+HeuristicEvaluator::Weights::Weights()
+{
+	base = 200000.0f;
+	empty = 270.0f;
+	merges = 700.0f;
+	monotonicity = 47.0f;
+	monotonicityPower = 4.0f;
+	smoothness = 0.0f;
+	lineEnd = 0.0f;
+	sum = 11.0f;
+	sumPower = 3.5f;
+}
+
+/**
+	@param size The size of the grid
+	@param weights The weight of each part of the value
+*/
+HeuristicEvaluator::HeuristicEvaluator(int size, const Weights& weights)
+{
+	m_size = size;
+	m_weights = weights;
+	m_rows = getRowTable(size, weights);
+}
+
+/**
+	Get the value of every possible row for a grid size and weights, computed on first use only
+	A simulation builds an AI per game : they all share the same few tables instead of computing their own
+
+	@param size The size of the grid
+	@param weights The weights
+	@return The values, indexed by packed row
+*/
+const float* HeuristicEvaluator::getRowTable(int size, const Weights& weights)
+{
+	static std::mutex mutex;
+	static std::vector<RowTable*> tables; // a program only ever uses a few weights, tables are never freed
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// Weights only hold floats, so they are compared byte by byte
+	for (size_t i = 0; i < tables.size(); i++) {
+		if (tables[i]->size == size && memcmp(&tables[i]->weights, &weights, sizeof(Weights)) == 0) {
+			return tables[i]->rows.data();
+		}
+	}
+
+	RowTable* table = new RowTable();
+	uint32_t rowCount = 1U << (4 * size);
+	int line[GRID_SIZE_MAX];
+
+	table->size = size;
+	table->weights = weights;
+	table->rows.resize(rowCount);
+
+	for (uint32_t row = 0; row < rowCount; row++) {
+		for (int i = 0; i < size; i++) {
+			line[i] = (int)(row >> (4 * i)) & 0xF;
+		}
+
+		table->rows[row] = evaluateLine(line, size, weights);
+	}
+
+	tables.push_back(table);
+
+	return table->rows.data();
+}
+
+/**
+	Value a single line, read from its first cell to its last one
+
+	@param line The exponents of the cells
+	@param size The number of cells of the line
+	@param weights The weights
+	@return The value of the line
+*/
+float HeuristicEvaluator::evaluateLine(const int* line, int size, const Weights& weights)
+{
+	float sum = 0.0f;
+	int empty = 0;
+	int merges = 0;
+	int maxExponent = 0;
+
+	// Empty cells, tiles and the merges a move along the line would make
+	int previous = EMPTY_EXPONENT;
+	int counter = 0;
+
+	for (int i = 0; i < size; i++) {
+		int exponent = line[i];
+
+		sum += std::pow((float)exponent, weights.sumPower);
+		maxExponent = std::max(maxExponent, exponent);
+
+		if (exponent == EMPTY_EXPONENT) {
+			++empty;
+			continue;
+		}
+
+		if (previous == exponent) {
+			++counter;
+		}
+		else if (counter > 0) {
+			merges += 1 + counter;
+			counter = 0;
+		}
+
+		previous = exponent;
+	}
+
+	if (counter > 0) {
+		merges += 1 + counter;
+	}
+
+	// Monotonicity, only the least broken direction is penalized
+	float increasing = 0.0f;
+	float decreasing = 0.0f;
+
+	for (int i = 1; i < size; i++) {
+		float before = std::pow((float)line[i - 1], weights.monotonicityPower);
+		float after = std::pow((float)line[i], weights.monotonicityPower);
+
+		if (line[i - 1] > line[i]) {
+			increasing += before - after;
+		}
+		else {
+			decreasing += after - before;
+		}
+	}
+
+	// Smoothness, the gaps between tiles next to each other once the empty cells are skipped
+	float gaps = 0.0f;
+
+	previous = EMPTY_EXPONENT;
+
+	for (int i = 0; i < size; i++) {
+		if (line[i] == EMPTY_EXPONENT) {
+			continue;
+		}
+
+		if (previous != EMPTY_EXPONENT) {
+			gaps += (float)std::abs(line[i] - previous);
+		}
+
+		previous = line[i];
+	}
+
+	// The biggest tile at an end of the line
+	bool isAtEnd = maxExponent > 0 && (line[0] == maxExponent || line[size - 1] == maxExponent);
+
+	return weights.base
+		+ weights.empty * empty
+		+ weights.merges * merges
+		- weights.monotonicity * std::min(increasing, decreasing)
+		- weights.smoothness * gaps
+		+ (isAtEnd ? weights.lineEnd * maxExponent : 0.0f)
+		- weights.sum * sum;
+}
+
+/**
+	Read weights from a config file, one "name value" or "name = value" per line, "#" starting a comment
+	Weights missing from the file keep their value
+
+	@param path The path of the file
+	@param weights The weights to update
+	@param error Where to tell why the file could not be read
+	@return If the whole file has been read
+*/
+bool HeuristicEvaluator::loadWeights(const std::string& path, Weights* weights, std::string* error)
+{
+	std::ifstream file(path);
+
+	if (!file) {
+		*error = "cannot open the file";
+		return false;
+	}
+
+	struct Entry
+	{
+		const char* name;
+		float* value;
+	};
+
+	Entry entries[] = {
+		{ "base", &weights->base },
+		{ "empty", &weights->empty },
+		{ "merges", &weights->merges },
+		{ "monotonicity", &weights->monotonicity },
+		{ "monotonicityPower", &weights->monotonicityPower },
+		{ "smoothness", &weights->smoothness },
+		{ "lineEnd", &weights->lineEnd },
+		{ "sum", &weights->sum },
+		{ "sumPower", &weights->sumPower }
+	};
+
+	std::string text;
+	int lineNumber = 0;
+
+	while (std::getline(file, text)) {
+		++lineNumber;
+		text = text.substr(0, text.find('#'));
+		std::replace(text.begin(), text.end(), '=', ' ');
+
+		std::istringstream line(text);
+		std::string name;
+		float value;
+
+		if (!(line >> name)) {
+			continue;
+		}
+
+		Entry* entry = std::find_if(std::begin(entries), std::end(entries), [&name](const Entry& entry) {
+			return name == entry.name;
+		});
+
+		if (entry == std::end(entries) || !(line >> value)) {
+			*error = "line " + std::to_string(lineNumber) + " : unknown weight or missing value";
+			return false;
+		}
+
+		*entry->value = value;
+	}
+
+	return true;
+}
+
+/**
+	Sum the values of the rows and of the columns
+
+	@param board The board
+	@return The value of the board
+*/
+float HeuristicEvaluator::evaluate(const Board& board) const
+{
+	Board columns = board.transpose();
+	float value = 0.0f;
+
+	for (int i = 0; i < m_size; i++) {
+		value += m_rows[board.getRow(i)] + m_rows[columns.getRow(i)];
+	}
+
+	return value;
+}
+
+const HeuristicEvaluator::Weights& HeuristicEvaluator::getWeights() const
+{
+	return m_weights;
+}
@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "Core/Bits.h"
+#include "Core/GameConstants.h"
+#include "AI/MonteCarlo.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+// A new tile is a 4 when 16 random bits fall below this
+static const uint32_t FOUR_THRESHOLD = (uint32_t)(TILE_FOUR_PROBABILITY * 65536.0);
+
+/**
+	@param playoutCount The number of playouts following each possible move, at least 1 so each move gets a mean
+	@param timeBudget The time allowed to choose a move, in milliseconds (0 to always play every playout, which keeps the search reproducible)
+*/
+MonteCarlo::MonteCarlo(int playoutCount, int timeBudget)
+{
+	m_playoutCount = std::max(playoutCount, 1);
+	m_timeBudget = timeBudget;
+	m_pool = nullptr;
+	m_evaluator = nullptr;
+	m_totalPlayoutCount = 0;
+	m_totalMoveCount = 0;
+}
+
+/**
+	Play the playouts of every possible move, batch by batch across the pool if there is one
+	Once the time budget is spent each batch stops after its current playout,
+	every batch plays at least one so each possible move gets a mean
+
+	@param board The current state of the game
+	@return The direction with the best mean value, DIR_NONE if no move is possible
+*/
+int MonteCarlo::chooseMove(const Board& board)
+{
+	struct BatchTask
+	{
+		int dir;
+		Board board;
+		uint64_t seed;
+		int playoutCount; // to play
+		double valueSum;
+		long long moveCount;
+		int playedCount;
+	};
+
+	m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_timeBudget);
+
+	int batchCount = (m_playoutCount + AI_NORMAL_BATCH_SIZE - 1) / AI_NORMAL_BATCH_SIZE;
+	int gains[DIR_COUNT] = { 0 };
+	bool isPossible[DIR_COUNT] = { false };
+	std::vector<BatchTask> tasks;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+
+		if (!next.move(dir, &gains[dir])) {
+			continue;
+		}
+
+		isPossible[dir] = true;
+
+		for (int batch = 0; batch < batchCount; batch++) {
+			BatchTask task;
+			task.dir = dir;
+			task.board = next;
+			task.seed = (board.getWord(0) ^ (board.getWord(1) << 32) ^ (board.getWord(1) >> 32))
+				+ 0x9E3779B97F4A7C15ULL * (uint64_t)(dir * batchCount + batch + 1);
+			task.playoutCount = batch < batchCount - 1 ? AI_NORMAL_BATCH_SIZE : m_playoutCount - batch * AI_NORMAL_BATCH_SIZE;
+			tasks.push_back(task);
+		}
+	}
+
+	std::function<void(int)> playBatch = [this, &tasks](int i) {
+		BatchTask& task = tasks[i];
+		Random random(task.seed);
+
+		task.valueSum = 0.0;
+		task.moveCount = 0;
+		task.playedCount = 0;
+
+		while (task.playedCount < task.playoutCount && (task.playedCount == 0 || !isTimeOut())) {
+			task.valueSum += playout(task.board, random, &task.moveCount);
+			++task.playedCount;
+		}
+	};
+
+	if (m_pool) {
+		m_pool->parallelFor((int)tasks.size(), playBatch);
+	}
+	else {
+		for (int i = 0; i < (int)tasks.size(); i++) {
+			playBatch(i);
+		}
+	}
+
+	double valueSums[DIR_COUNT] = { 0.0 };
+	long long playedCounts[DIR_COUNT] = { 0 };
+
+	for (size_t i = 0; i < tasks.size(); i++) {
+		valueSums[tasks[i].dir] += tasks[i].valueSum;
+		playedCounts[tasks[i].dir] += tasks[i].playedCount;
+		m_totalPlayoutCount += tasks[i].playedCount;
+		m_totalMoveCount += tasks[i].moveCount;
+	}
+
+	int bestDir = DIR_NONE;
+	double bestValue = 0.0;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		if (!isPossible[dir]) {
+			continue;
+		}
+
+		double value = gains[dir] + valueSums[dir] / playedCounts[dir];
+
+		if (bestDir == DIR_NONE || value > bestValue) {
+			bestDir = dir;
+			bestValue = value;
+		}
+	}
+
+	return bestDir;
+}
+
+/**
+	Play random moves until the game is over, or with an evaluator until the playout depth
+	A single draw of the generator gives the whole turn : the first direction to try, the new tile value and its cell
+
+	@param board The board to play from, after a player move
+	@param random The generator of the batch
+	@param moveCount Where to count the moves played
+	@return The score gained during the playout, plus the value of its last board if it has been cut,
+		GAME_OVER_VALUE if it could have been cut but lost before
+*/
+float MonteCarlo::playout(Board board, Random& random, long long* moveCount)
+{
+	int size = board.getSize();
+	int score = 0;
+	int depth = 0;
+
+	for (;;) {
+		uint64_t bits = random.next();
+
+		// The tile of the turn, a board that has just moved always has an empty cell
+		uint32_t empty = board.getEmptyMask();
+		int index = selectBit(empty, (int)(((bits >> 32) * (uint64_t)popCount(empty)) >> 32));
+		int exponent = ((uint32_t)(bits >> 8) & 0xFFFF) < FOUR_THRESHOLD ? 2 : 1;
+
+		board.setExponent(index % size, index / size, exponent);
+
+		// Random direction, the next ones in turn if it does not change the board
+		int first = (int)(bits & 3);
+		int gained = 0;
+		int i = 0;
+
+		while (i < DIR_COUNT && !board.move((first + i) & 3, &gained)) {
+			++i;
+		}
+
+		// Evaluators may value a living board below 0, a lost playout must still be worth less
+		if (i == DIR_COUNT) {
+			return m_evaluator ? GAME_OVER_VALUE : (float)score;
+		}
+
+		score += gained;
+		++*moveCount;
+
+		if (m_evaluator && ++depth == AI_NORMAL_PLAYOUT_DEPTH) {
+			return score + m_evaluator->evaluate(board);
+		}
+	}
+}
+
+bool MonteCarlo::isTimeOut()
+{
+	return m_timeBudget > 0 && std::chrono::steady_clock::now() >= m_deadline;
+}
+
+/**
+	Get the number of playouts played since the search was created
+
+	@return The number of playouts
+*/
+long long MonteCarlo::getTotalPlayoutCount()
+{
+	return m_totalPlayoutCount;
+}
+
+/**
+	Get the number of random moves played by the playouts since the search was created
+
+	@return The number of moves
+*/
+long long MonteCarlo::getTotalMoveCount()
+{
+	return m_totalMoveCount;
+}
+
+/**
+	Share a thread pool with the search, null to search sequentially
+
+	@param pool The thread pool
+*/
+void MonteCarlo::setThreadPool(ThreadPool* pool)
+{
+	m_pool = pool;
+}
+
+/**
+	Share an evaluator with the search, null to play every playout to the game over
+
+	@param evaluator The evaluator
+*/
+void MonteCarlo::setEvaluator(const Evaluator* evaluator)
+{
+	m_evaluator = evaluator;
+}
@@ -0,0 +1,292 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "AI/NTupleNetwork.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// Tuples of each grid size, cells given as y * size + x
+static const int TUPLES_3[][NTUPLE_LENGTH] = {
+	{ 0, 1, 2, 3, 4, 5 },
+	{ 0, 1, 2, 4, 5, 8 }
+};
+
+static const int TUPLES_4[][NTUPLE_LENGTH] = {
+	{ 0, 1, 2, 3, 4, 5 },
+	{ 4, 5, 6, 7, 8, 9 },
+	{ 0, 1, 2, 4, 5, 6 },
+	{ 4, 5, 6, 8, 9, 10 }
+};
+
+static const int TUPLES_5[][NTUPLE_LENGTH] = {
+	{ 0, 1, 2, 5, 6, 7 },
+	{ 1, 2, 3, 6, 7, 8 },
+	{ 5, 6, 7, 10, 11, 12 },
+	{ 6, 7, 8, 11, 12, 13 }
+};
+
+static const size_t WEIGHTS_PER_TUPLE = (size_t)1 << (4 * NTUPLE_LENGTH);
+static const size_t CACHE_LINE_FLOATS = 64 / sizeof(float);
+
+/**
+	Create a network without any weight, they are either loaded or made writable before use
+
+	@param size The size of the grid
+*/
+NTupleNetwork::NTupleNetwork(int size)
+{
+	m_size = size;
+	m_weights = nullptr;
+	m_table = nullptr;
+
+	initializeTuples();
+
+	m_weightCount = m_tupleCount * WEIGHTS_PER_TUPLE;
+}
+
+/**
+	Compute the cells of every tuple in every symmetry of the board, once and for all
+*/
+void NTupleNetwork::initializeTuples()
+{
+	const int (*tuples)[NTUPLE_LENGTH];
+
+	switch (m_size) {
+	case 3:
+		tuples = TUPLES_3;
+		m_tupleCount = sizeof(TUPLES_3) / sizeof(TUPLES_3[0]);
+		break;
+	case 4:
+		tuples = TUPLES_4;
+		m_tupleCount = sizeof(TUPLES_4) / sizeof(TUPLES_4[0]);
+		break;
+	default:
+		tuples = TUPLES_5;
+		m_tupleCount = sizeof(TUPLES_5) / sizeof(TUPLES_5[0]);
+		break;
+	}
+
+	int last = m_size - 1;
+
+	// FNV-1a hash of the tuples
+	m_layout = 0xCBF29CE484222325ULL;
+
+	for (int tuple = 0; tuple < m_tupleCount; tuple++) {
+		for (int i = 0; i < NTUPLE_LENGTH; i++) {
+			m_layout = (m_layout ^ (uint64_t)tuples[tuple][i]) * 0x100000001B3ULL;
+		}
+
+		m_layout = (m_layout ^ 0xFF) * 0x100000001B3ULL;
+	}
+
+	for (int tuple = 0; tuple < m_tupleCount; tuple++) {
+		for (int symmetry = 0; symmetry < NTUPLE_SYMMETRY_COUNT; symmetry++) {
+			for (int i = 0; i < NTUPLE_LENGTH; i++) {
+				int x = tuples[tuple][i] % m_size;
+				int y = tuples[tuple][i] / m_size;
+
+				// Reflections on both axes, then on the diagonal
+				if (symmetry & 1) {
+					x = last - x;
+				}
+
+				if (symmetry & 2) {
+					y = last - y;
+				}
+
+				if (symmetry & 4) {
+					std::swap(x, y);
+				}
+
+				m_cells.push_back(y * m_size + x);
+			}
+		}
+	}
+}
+
+/**
+	Map the weights of a weight file, read-only
+	The weights of each tuple follow one another, in the order of the tuples
+
+	@param path The path of the file
+	@return If the file holds the weights of this network, getLoadError tells why not otherwise and the weights in use are kept
+*/
+bool NTupleNetwork::load(const std::string& path)
+{
+	if (!m_file.open(path, WeightFile::createHeader(WEIGHT_KIND_NTUPLE, m_size, m_layout, m_weightCount))) {
+		return false;
+	}
+
+	m_storage.clear();
+	m_storage.shrink_to_fit();
+	m_weights = nullptr;
+	m_table = m_file.getWeights();
+
+	return true;
+}
+
+/**
+	Write the weights in the format load reads
+
+	@param path The path of the file
+	@return If the whole file has been written
+*/
+bool NTupleNetwork::save(const std::string& path) const
+{
+	if (!m_table) {
+		return false;
+	}
+
+	return WeightFile::write(path, WeightFile::createHeader(WEIGHT_KIND_NTUPLE, m_size, m_layout, m_weightCount), m_table);
+}
+
+/**
+	Copy the weights in memory of its own so they can be trained, from the mapped file if any or from zero
+	The copy starts on a cache line, like the tables of each tuple
+*/
+void NTupleNetwork::makeWritable()
+{
+	if (m_weights) {
+		return;
+	}
+
+	m_storage.assign(m_weightCount + CACHE_LINE_FLOATS, 0.0f);
+
+	uintptr_t address = (uintptr_t)m_storage.data();
+
+	m_weights = m_storage.data() + ((64 - address % 64) % 64) / sizeof(float);
+
+	if (m_table) {
+		std::copy(m_table, m_table + m_weightCount, m_weights);
+		m_file.close();
+	}
+
+	m_table = m_weights;
+}
+
+/**
+	Move the value of a board towards a target, each weight of the board taking its share
+
+	@param board The board
+	@param delta What to add to each weight the board is evaluated with
+*/
+void NTupleNetwork::update(const Board& board, float delta)
+{
+	int cells[GRID_SIZE_MAX * GRID_SIZE_MAX];
+
+	loadCells(board, cells);
+
+	for (int tuple = 0; tuple < m_tupleCount; tuple++) {
+		float* weights = m_weights + tuple * WEIGHTS_PER_TUPLE;
+
+		for (int symmetry = 0; symmetry < NTUPLE_SYMMETRY_COUNT; symmetry++) {
+			weights[getIndex(cells, tuple, symmetry)] += delta;
+		}
+	}
+}
+
+/**
+	Sum the weights of every tuple in every symmetry of the board
+
+	@param board The board
+	@return The expected score still to be made from the board
+*/
+float NTupleNetwork::evaluate(const Board& board) const
+{
+	int cells[GRID_SIZE_MAX * GRID_SIZE_MAX];
+	const float* lookups[NTUPLE_MAX_COUNT * NTUPLE_SYMMETRY_COUNT];
+	int lookupCount = 0;
+	float value = 0.0f;
+
+	loadCells(board, cells);
+
+	// Every address first, so the loads of the weights, mostly cache misses, are all in flight at once
+	for (int tuple = 0; tuple < m_tupleCount; tuple++) {
+		const float* weights = m_table + tuple * WEIGHTS_PER_TUPLE;
+
+		for (int symmetry = 0; symmetry < NTUPLE_SYMMETRY_COUNT; symmetry++) {
+			lookups[lookupCount++] = weights + getIndex(cells, tuple, symmetry);
+		}
+	}
+
+	for (int i = 0; i < lookupCount; i++) {
+		value += *lookups[i];
+	}
+
+	return value;
+}
+
+/**
+	Unpack the exponent of every cell, row by row
+
+	@param board The board
+	@param cells Where to store the exponents, indexed by y * size + x
+*/
+void NTupleNetwork::loadCells(const Board& board, int* cells) const
+{
+	for (int y = 0; y < m_size; y++) {
+		uint32_t row = board.getRow(y);
+
+		for (int x = 0; x < m_size; x++) {
+			cells[y * m_size + x] = (int)(row >> (4 * x)) & 0xF;
+		}
+	}
+}
+
+/**
+	Get the index of the weight of a tuple in a symmetry of the board
+
+	@param cells The exponents of the board
+	@param tuple The tuple
+	@param symmetry The symmetry
+	@return The index, in the table of the tuple
+*/
+size_t NTupleNetwork::getIndex(const int* cells, int tuple, int symmetry) const
+{
+	const int* tupleCells = &m_cells[(tuple * NTUPLE_SYMMETRY_COUNT + symmetry) * NTUPLE_LENGTH];
+	size_t index = 0;
+
+	for (int i = 0; i < NTUPLE_LENGTH; i++) {
+		index |= (size_t)cells[tupleCells[i]] << (4 * i);
+	}
+
+	return index;
+}
+
+/**
+	Check if the network has weights to evaluate with
+
+	@return If the weights are mapped or writable
+*/
+bool NTupleNetwork::isLoaded() const
+{
+	return m_table != nullptr;
+}
+
+int NTupleNetwork::getSize() const
+{
+	return m_size;
+}
+
+/**
+	Get the number of weights a board is evaluated with
+
+	@return The number of lookups
+*/
+int NTupleNetwork::getLookupCount() const
+{
+	return m_tupleCount * NTUPLE_SYMMETRY_COUNT;
+}
+
+size_t NTupleNetwork::getWeightCount() const
+{
+	return m_weightCount;
+}
+
+/**
+	@return Why the last weight file could not be loaded
+*/
+const std::string& NTupleNetwork::getLoadError() const
+{
+	return m_file.getError();
+}
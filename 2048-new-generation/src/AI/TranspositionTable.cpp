@@ -0,0 +1,337 @@
+#include "pch.h"
+#include "AI/TranspositionTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Zobrist keys : one random key per byte value for each byte lane of the two board words
+// plus one lane keyed by the board size so boards of different sizes never share a hash
+static const int ZOBRIST_LANES = 17;
+static const int ZOBRIST_SIZE_LANE = 16;
+
+// Entry data layout
+static const uint64_t DATA_USED = 1ULL << 63; // a stored entry never has null data
+static const int DATA_DEPTH_SHIFT = 32;
+static const int DATA_PROBABILITY_SHIFT = 40;
+
+// Counters
+static const int COUNTER_STRIPES = 16;
+
+static const size_t CACHE_LINE_SIZE = 64;
+
+/**
+	Build the Zobrist keys from a fixed seed so hashes are the same from one run to another
+
+	@return The keys, 256 per lane
+*/
+static std::vector<uint64_t> buildZobristKeys()
+{
+	std::vector<uint64_t> keys(ZOBRIST_LANES * 256);
+	uint64_t state = 0x2048204820482048ULL;
+
+	// splitmix64
+	for (size_t i = 0; i < keys.size(); i++) {
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		keys[i] = z ^ (z >> 31);
+	}
+
+	return keys;
+}
+
+/**
+	@param sizeLog2 The log2 of the number of entries (an entry takes 16 bytes), at least one bucket
+	@param policy TT_REPLACE_ALWAYS or TT_REPLACE_DEEPER
+*/
+TranspositionTable::TranspositionTable(int sizeLog2, int policy)
+{
+	sizeLog2 = std::max(sizeLog2, 2);
+
+	// A few more entries so the buckets can start on a cache line
+	m_entries = std::vector<Entry>(((size_t)1 << sizeLog2) + CACHE_LINE_SIZE / sizeof(Entry) - 1);
+	m_first = ((CACHE_LINE_SIZE - (uintptr_t)m_entries.data() % CACHE_LINE_SIZE) % CACHE_LINE_SIZE) / sizeof(Entry);
+	m_counters = std::vector<Counters>(COUNTER_STRIPES);
+	m_mask = ((uint64_t)1 << sizeLog2) - TT_BUCKET_SIZE;
+	m_policy = policy;
+
+	clear();
+	resetCounters();
+}
+
+/**
+	Get the Zobrist keys, built on first use
+
+	@return The keys, 256 per lane
+*/
+const uint64_t* TranspositionTable::getZobristKeys()
+{
+	static const std::vector<uint64_t> keys = buildZobristKeys();
+
+	return keys.data();
+}
+
+/**
+	Hash a board by xoring the Zobrist key of each byte of its packed words
+	A byte holds two cells so a 4x4 board costs 8 lookups and a 5x5 one 13
+
+	@param board The board to hash
+	@return The 64-bit hash
+*/
+uint64_t TranspositionTable::hash(const Board& board)
+{
+	const uint64_t* keys = getZobristKeys();
+	uint64_t h = keys[ZOBRIST_SIZE_LANE * 256 + board.getSize()];
+	uint64_t word = board.getWord(0);
+
+	for (int lane = 0; lane < 8; lane++) {
+		h ^= keys[lane * 256 + ((word >> (8 * lane)) & 0xFF)];
+	}
+
+	// Only the 5x5 board uses the second word
+	if (board.getSize() == SIZE_AI_HARD) {
+		word = board.getWord(1);
+
+		for (int lane = 0; lane < 8; lane++) {
+			h ^= keys[(8 + lane) * 256 + ((word >> (8 * lane)) & 0xFF)];
+		}
+	}
+
+	return h;
+}
+
+/**
+	Look for the value of a board searched at least as deep and as likely as requested
+
+	@param key The hash of the board
+	@param depth The depth the board is about to be searched at
+	@param probability The probability to reach the board
+	@param value Where to store the cached value
+	@return If a usable value has been found
+*/
+bool TranspositionTable::probe(uint64_t key, int depth, float probability, float* value)
+{
+	const Entry* bucket = getBucket(key);
+	Counters& counters = getCounters();
+	uint64_t data = 0;
+	int usedCount = 0;
+	int i = 0;
+
+	for (; i < TT_BUCKET_SIZE; i++) {
+		data = bucket[i].data.load(std::memory_order_relaxed);
+
+		if ((bucket[i].check.load(std::memory_order_relaxed) ^ data) == key) {
+			break;
+		}
+
+		usedCount += data != 0 ? 1 : 0;
+	}
+
+	if (i == TT_BUCKET_SIZE) {
+		// The bucket is full of other boards, this one may have been replaced
+		if (usedCount == TT_BUCKET_SIZE) {
+			counters.collisions.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+		return false;
+	}
+
+	// A board reached with a higher probability has been searched more thoroughly
+	// Probabilities are compared on their quantized form so equal ones always match
+	if (unpackDepth(data) < depth || unpackProbability(data) < quantizeProbability(probability)) {
+		counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+		return false;
+	}
+
+	*value = unpackValue(data);
+	counters.hits.fetch_add(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+/**
+	Store the value of a searched board in its entry of the bucket, a free one, or else its shallowest one
+	according to the replacement policy
+
+	@param key The hash of the board
+	@param depth The depth the board has been searched at
+	@param probability The probability to reach the board
+	@param value The value computed by the search
+*/
+void TranspositionTable::store(uint64_t key, int depth, float probability, float value)
+{
+	Entry* bucket = getBucket(key);
+	Entry* victim = nullptr;
+	int victimDepth = 0;
+
+	for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+		uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+
+		// The same board searched again, or a free entry
+		if (data == 0 || (bucket[i].check.load(std::memory_order_relaxed) ^ data) == key) {
+			victim = &bucket[i];
+			victimDepth = -1;
+			break;
+		}
+
+		if (!victim || unpackDepth(data) < victimDepth) {
+			victim = &bucket[i];
+			victimDepth = unpackDepth(data);
+		}
+	}
+
+	if (m_policy == TT_REPLACE_DEEPER && victimDepth > depth) {
+		return;
+	}
+
+	Entry& entry = *victim;
+	uint64_t data;
+
+	// Two threads storing at once may mix their words, the check then no longer matches any key
+	data = pack(value, depth, probability);
+	entry.data.store(data, std::memory_order_relaxed);
+	entry.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+	Empty every slot of the table
+*/
+void TranspositionTable::clear()
+{
+	for (size_t i = 0; i < m_entries.size(); i++) {
+		m_entries[i].check.store(0, std::memory_order_relaxed);
+		m_entries[i].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+/**
+	Reset the hit, miss and collision counters
+*/
+void TranspositionTable::resetCounters()
+{
+	for (size_t i = 0; i < m_counters.size(); i++) {
+		m_counters[i].hits = 0;
+		m_counters[i].misses = 0;
+		m_counters[i].collisions = 0;
+	}
+}
+
+/**
+	Get the first entry of the bucket of a key
+
+	@param key The hash of the board
+	@return The entry, followed by the TT_BUCKET_SIZE - 1 others of the bucket
+*/
+TranspositionTable::Entry* TranspositionTable::getBucket(uint64_t key)
+{
+	return &m_entries[m_first + (key & m_mask)];
+}
+
+/**
+	Get the counters stripe of the calling thread
+
+	@return The counters
+*/
+TranspositionTable::Counters& TranspositionTable::getCounters()
+{
+	static std::atomic<int> nextStripe(0);
+	static thread_local int stripe = nextStripe++ % COUNTER_STRIPES;
+
+	return m_counters[stripe];
+}
+
+/**
+	Pack an entry's data in a single word : value on bits 0-31, depth on 32-39, probability on 40-55
+
+	@return The packed data
+*/
+uint64_t TranspositionTable::pack(float value, int depth, float probability)
+{
+	uint32_t valueBits;
+	std::memcpy(&valueBits, &value, sizeof(valueBits));
+
+	return DATA_USED
+		| (uint64_t)valueBits
+		| ((uint64_t)(depth & 0xFF) << DATA_DEPTH_SHIFT)
+		| ((uint64_t)quantizeProbability(probability) << DATA_PROBABILITY_SHIFT);
+}
+
+float TranspositionTable::unpackValue(uint64_t data)
+{
+	uint32_t valueBits = (uint32_t)data;
+	float value;
+	std::memcpy(&value, &valueBits, sizeof(value));
+
+	return value;
+}
+
+int TranspositionTable::unpackDepth(uint64_t data)
+{
+	return (int)((data >> DATA_DEPTH_SHIFT) & 0xFF);
+}
+
+int TranspositionTable::unpackProbability(uint64_t data)
+{
+	return (int)((data >> DATA_PROBABILITY_SHIFT) & 0xFFFF);
+}
+
+/**
+	Quantize a probability on 16 bits, rounded down
+	The bits of a positive float grow with its value so its upper half keeps the ordering
+
+	@param probability The probability, in ]0, 1]
+	@return The quantized probability
+*/
+int TranspositionTable::quantizeProbability(float probability)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &probability, sizeof(bits));
+
+	return (int)(bits >> 16);
+}
+
+long long TranspositionTable::getHits()
+{
+	long long hits = 0;
+
+	for (size_t i = 0; i < m_counters.size(); i++) {
+		hits += m_counters[i].hits;
+	}
+
+	return hits;
+}
+
+long long TranspositionTable::getMisses()
+{
+	long long misses = 0;
+
+	for (size_t i = 0; i < m_counters.size(); i++) {
+		misses += m_counters[i].misses;
+	}
+
+	return misses;
+}
+
+long long TranspositionTable::getCollisions()
+{
+	long long collisions = 0;
+
+	for (size_t i = 0; i < m_counters.size(); i++) {
+		collisions += m_counters[i].collisions;
+	}
+
+	return collisions;
+}
+
+size_t TranspositionTable::getCapacity()
+{
+	return (size_t)m_mask + TT_BUCKET_SIZE;
+}
+
+size_t TranspositionTable::getMemorySize()
+{
+	return m_entries.size() * sizeof(Entry);
+}
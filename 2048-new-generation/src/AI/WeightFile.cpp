@@ -0,0 +1,186 @@
+#include "pch.h"
+#include "AI/WeightFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+static const char MAGIC[8] = { '2', '0', '4', '8', 'W', 'G', 'T', '\0' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const uint64_t DATA_ALIGNMENT = 4096; // a page
+
+WeightFile::WeightFile()
+{
+	m_weights = nullptr;
+}
+
+/**
+	Describe the weights of an evaluator, for the current version of the format
+
+	@param kind The kind of evaluator (WEIGHT_KIND_*)
+	@param gridSize The size of the grid the weights are trained for
+	@param layout The hash of how the evaluator indexes its weights
+	@param weightCount The number of weights
+	@return The header
+*/
+WeightFile::Header WeightFile::createHeader(uint32_t kind, uint32_t gridSize, uint64_t layout, uint64_t weightCount)
+{
+	Header header;
+
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = WEIGHT_FILE_VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.kind = kind;
+	header.gridSize = gridSize;
+	header.layout = layout;
+	header.weightCount = weightCount;
+	header.dataOffset = DATA_ALIGNMENT;
+	header.reserved = 0;
+
+	return header;
+}
+
+/**
+	Write the header, padding up to the weights, then the weights
+	The file is written aside then renamed, so the processes still mapping the previous one keep reading it whole
+
+	@param path The path of the file
+	@param header The header, from createHeader
+	@param weights The weights, as many as the header says
+	@return If the whole file has been written
+*/
+bool WeightFile::write(const std::string& path, const Header& header, const float* weights)
+{
+	std::string temporary = path + ".tmp";
+	std::vector<char> padding((size_t)header.dataOffset - sizeof(Header), 0);
+
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+		file.write((const char*)&header, sizeof(Header));
+		file.write(padding.data(), (std::streamsize)padding.size());
+		file.write((const char*)weights, (std::streamsize)(header.weightCount * sizeof(float)));
+
+		if (!file) {
+			file.close();
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+
+#ifdef _WIN32
+	std::remove(path.c_str());
+#endif
+
+	if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+	Map a file and check it holds the expected weights
+	Only the header is read here, the weights are read from the disk as the evaluator touches them
+
+	@param path The path of the file
+	@param expected The header the evaluator would write, from createHeader
+	@return If the weights can be used, getError tells why not otherwise
+		and the file already open, if any, stays open
+*/
+bool WeightFile::open(const std::string& path, const Header& expected)
+{
+	// The weights in use are only unmapped once the new ones are known to be valid
+	MappedFile file;
+
+	if (!file.open(path)) {
+		m_error = "cannot open the file";
+		return false;
+	}
+
+	if (file.getSize() < sizeof(Header)) {
+		m_error = "not a weight file";
+		return false;
+	}
+
+	const Header& header = *(const Header*)file.getData();
+
+	if (!check(header, expected, file.getSize())) {
+		return false;
+	}
+
+	// Evaluators read their weights in no particular order, reading ahead would only waste memory
+	file.adviseRandomAccess();
+	m_file.swap(file);
+	m_weights = (const float*)((const char*)m_file.getData() + header.dataOffset);
+
+	return true;
+}
+
+/**
+	Compare a header with the expected one, field by field
+
+	@param header The header of the file
+	@param expected The expected header
+	@param fileSize The size of the file, in bytes
+	@return If the header matches, the reason why not is kept otherwise
+*/
+bool WeightFile::check(const Header& header, const Header& expected, size_t fileSize)
+{
+	if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+		m_error = "not a weight file";
+	}
+	else if (header.byteOrder != BYTE_ORDER_MARK) {
+		m_error = "written on a machine of another endianness";
+	}
+	else if (header.version != expected.version) {
+		m_error = "version " + std::to_string(header.version) + ", version " + std::to_string(expected.version) + " expected";
+	}
+	else if (header.kind != expected.kind) {
+		m_error = "weights of another kind of evaluator";
+	}
+	else if (header.gridSize != expected.gridSize) {
+		m_error = "weights of a " + std::to_string(header.gridSize) + "x" + std::to_string(header.gridSize)
+			+ " grid, " + std::to_string(expected.gridSize) + "x" + std::to_string(expected.gridSize) + " expected";
+	}
+	else if (header.layout != expected.layout || header.weightCount != expected.weightCount) {
+		m_error = "weights of another layout of the evaluator";
+	}
+	else if (header.dataOffset < sizeof(Header) || header.dataOffset % 64 != 0
+		|| fileSize != header.dataOffset + header.weightCount * sizeof(float)) {
+		m_error = "truncated or damaged file";
+	}
+	else {
+		m_error.clear();
+		return true;
+	}
+
+	return false;
+}
+
+/**
+	Unmap the file, the weights can not be read anymore
+*/
+void WeightFile::close()
+{
+	m_file.close();
+	m_weights = nullptr;
+}
+
+/**
+	@return The weights, null if no file is open
+*/
+const float* WeightFile::getWeights() const
+{
+	return m_weights;
+}
+
+/**
+	@return Why the last file could not be opened
+*/
+const std::string& WeightFile::getError() const
+{
+	return m_error;
+}
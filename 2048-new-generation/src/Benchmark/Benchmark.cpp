@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "Benchmark/Benchmark.h"
+#include "Core/Game.h"
+#include "Core/GameConstants.h"
+#include "Core/Random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Boards per timed batch : a single operation is shorter than the clock resolution, a batch is a few microseconds
+static const size_t BATCH_SIZE = 64;
+
+/**
+	Get the value below which the provided share of the sorted values lie (nearest rank)
+
+	@param sorted The values, in ascending order
+	@param percent The share, between 0 and 100
+	@return The percentile
+*/
+static double getPercentile(const std::vector<double>& sorted, int percent)
+{
+	size_t rank = (sorted.size() * percent + 99) / 100;
+
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+	@param seed The seed the boards of the corpora are drawn from
+	@param boardCount The number of boards per grid size
+	@param sampleCount The number of timed passes over each corpus
+*/
+Benchmark::Benchmark(uint64_t seed, int boardCount, int sampleCount)
+{
+	m_seed = seed;
+	m_boardCount = std::max(boardCount, 1);
+	m_sampleCount = std::max(sampleCount, 1);
+	m_sink = 0;
+}
+
+/**
+	Collect the boards met while playing random moves, from the first spawns to the game over
+	A uniform random board would be nothing like a real one : games give the usual mix of empty cells,
+	merges and large tiles
+
+	@param size The size of the grid
+	@return The boards
+*/
+std::vector<Board> Benchmark::buildCorpus(int size)
+{
+	std::vector<Board> corpus;
+	uint64_t state = m_seed + (uint64_t)size;
+	Random random(Random::splitMix(state));
+
+	corpus.reserve(m_boardCount);
+
+	while ((int)corpus.size() < m_boardCount) {
+		Game game(size, random.next());
+
+		game.start();
+
+		while ((int)corpus.size() < m_boardCount && game.isMovePossible()) {
+			corpus.push_back(game.getBoard());
+
+			// Random moves, retried until one changes the board
+			while (!game.play(random.nextInt(DIR_COUNT))) {
+			}
+		}
+	}
+
+	return corpus;
+}
+
+/**
+	Time a kernel over several passes after a warm-up one
+	Each pass times the corpus batch by batch, every batch giving a sample of the cost of an operation
+
+	@param opsPerBoard The number of operations the kernel does on each board
+	@param kernel The kernel, run on the boards [begin, end) of the corpus and returning a value depending on every operation it did
+	@return The cost of an operation over the batches of every pass
+*/
+Benchmark::Stats Benchmark::measure(int opsPerBoard, const std::function<uint64_t(size_t, size_t)>& kernel)
+{
+	size_t boardCount = (size_t)m_boardCount;
+	std::vector<double> samples;
+	double total = 0.0;
+
+	samples.reserve(((boardCount + BATCH_SIZE - 1) / BATCH_SIZE) * m_sampleCount);
+	m_sink = m_sink + kernel(0, boardCount);
+
+	for (int i = 0; i < m_sampleCount; i++) {
+		for (size_t begin = 0; begin < boardCount; begin += BATCH_SIZE) {
+			size_t end = std::min(begin + BATCH_SIZE, boardCount);
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			uint64_t result = kernel(begin, end);
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+
+			m_sink = m_sink + result;
+			samples.push_back(nanoseconds / (double)((end - begin) * opsPerBoard));
+			total += nanoseconds;
+		}
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	Stats stats;
+	stats.mean = total / ((double)boardCount * opsPerBoard * m_sampleCount);
+	stats.min = samples.front();
+	stats.p50 = getPercentile(samples, 50);
+	stats.p90 = getPercentile(samples, 90);
+	stats.p99 = getPercentile(samples, 99);
+
+	return stats;
+}
+
+/**
+	Print a line of results
+
+	@param name The name of the kernel
+	@param size The size of the grid
+	@param stats The cost of an operation
+*/
+void Benchmark::report(const char* name, int size, const Stats& stats)
+{
+	std::cout << std::left << std::setw(10) << name << size << "x" << size << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << stats.min
+		<< std::setw(10) << stats.mean
+		<< std::setw(10) << stats.p50
+		<< std::setw(10) << stats.p90
+		<< std::setw(10) << stats.p99
+		<< std::setw(14) << std::setprecision(0) << 1e9 / stats.mean << std::endl;
+}
+
+/**
+	Measure every kernel on every grid size and print the results
+*/
+void Benchmark::run()
+{
+	std::cout << "Seed " << m_seed << ", " << m_boardCount << " boards, " << m_sampleCount << " samples" << std::endl;
+	std::cout << std::left << std::setw(13) << "kernel" << std::right
+		<< std::setw(10) << "min ns"
+		<< std::setw(10) << "mean ns"
+		<< std::setw(10) << "p50 ns"
+		<< std::setw(10) << "p90 ns"
+		<< std::setw(10) << "p99 ns"
+		<< std::setw(14) << "ops/s" << std::endl;
+
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		std::vector<Board> corpus = buildCorpus(size);
+		Game game(size, m_seed);
+
+		Stats move = measure(DIR_COUNT, [&corpus](size_t begin, size_t end) {
+			uint64_t sum = 0;
+
+			for (size_t i = begin; i < end; i++) {
+				for (int dir = 0; dir < DIR_COUNT; dir++) {
+					Board board = corpus[i];
+					int score = 0;
+
+					board.move(dir, &score);
+					sum += board.getWord(0) ^ board.getWord(1) ^ (uint64_t)score;
+				}
+			}
+
+			return sum;
+		});
+
+		Stats spawn = measure(1, [&corpus, &game](size_t begin, size_t end) {
+			uint64_t sum = 0;
+
+			for (size_t i = begin; i < end; i++) {
+				game.setBoard(corpus[i]);
+				sum += (uint64_t)game.spawnTile();
+			}
+
+			return sum;
+		});
+
+		Stats gameOver = measure(1, [&corpus](size_t begin, size_t end) {
+			uint64_t sum = 0;
+
+			for (size_t i = begin; i < end; i++) {
+				sum += corpus[i].hasAnyMove() ? 1 : 0;
+			}
+
+			return sum;
+		});
+
+		report("move", size, move);
+		report("spawn", size, spawn);
+		report("hasMove", size, gameOver);
+	}
+
+	std::cout << "Checksum " << m_sink << std::endl;
+}
@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "Benchmark/Benchmark.h"
+#include "Core/Options.h"
+
+/**
+	Measure the game core kernels on --boards boards per grid size drawn from --seed,
+	each timed over --samples passes
+*/
+int main(int argc, char** argv)
+{
+	Options options(argc, argv);
+
+	Benchmark benchmark(
+		options.getUInt64("seed", 2048),
+		options.getInt("boards", 100000),
+		options.getInt("samples", 50)
+	);
+
+	benchmark.run();
+
+	return 0;
+}
@@ -0,0 +1,950 @@
+#include "pch.h"
+#include "Check/Check.h"
+#include "AI/AI.h"
+#include "AI/Expectimax.h"
+#include "AI/HeuristicEvaluator.h"
+#include "AI/MonteCarlo.h"
+#include "AI/NTupleNetwork.h"
+#include "AI/TranspositionTable.h"
+#include "Core/Bits.h"
+#include "Core/GameConstants.h"
+#include "Core/MoveTrace.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Failures printed per run, the following ones are only counted
+static const int MAX_PRINTED_FAILURES = 20;
+
+// Known answers of the generators : splitmix64 of seed 1234567 from its reference implementation,
+// then xoshiro256** of seed 0 and nextInt(10) of seed 2048, the state being seeded by splitmix64
+static const uint64_t SPLITMIX_SEED = 1234567;
+static const uint64_t SPLITMIX_OUTPUTS[] = {
+	6457827717110365317ULL, 3203168211198807973ULL, 9817491932198370423ULL, 4593380528125082431ULL, 16408922859458223821ULL
+};
+static const uint64_t XOSHIRO_OUTPUTS[] = {
+	0x99EC5F36CB75F2B4ULL, 0xBF6E1F784956452AULL, 0x1A5F849D4933E6E0ULL, 0x6AA594F1262D2D2CULL
+};
+static const int NEXT_INT_OUTPUTS[] = { 9, 6, 2, 4, 8, 9, 5, 1 };
+
+// Bounds of nextInt drawn from, the small ones until every value has been drawn
+static const int NEXT_INT_BOUNDS[] = { 1, 2, 3, 5, 9, 10, 16, 25, 1000, 1 << 30, INT_MAX };
+static const int NEXT_INT_DRAW_COUNT = 10000;
+static const int NEXT_INT_MAX_FULL_BOUND = 25;
+
+// Moves of the hard games played twice, enough for the search to reach its whole depth many times
+static const int HARD_GAME_MOVE_COUNT = 20;
+
+// Searches compared on a few boards per grid size, each search being much slower than a move
+static const int SEARCH_BOARD_COUNT = 20;
+static const int SEARCH_PLAYOUT_COUNT = 50;
+static const int SEARCH_DEPTH = 2;
+static const int SEARCH_THREAD_COUNT = 4;
+
+// Spawns repeated on the same board per empty cell, so every empty cell is reached
+static const int SPAWNS_PER_EMPTY_CELL = 64;
+static const int SPAWN_BOARD_COUNT = 100;
+
+// Boards per grid size valued in their 8 symmetries, and how far apart the values may be
+// as the evaluators add the same terms in another order
+static const int EVALUATOR_BOARD_COUNT = 500;
+static const float EVALUATOR_TOLERANCE = 1e-5f;
+
+// Weight files written by the checks, in the working directory, removed once checked
+static const std::string WEIGHT_FILE_PATH = "2048-check-weights.bin";
+static const std::string BAD_WEIGHT_FILE_PATH = "2048-check-weights-bad.bin";
+
+/**
+	@param seed The seed the boards are drawn from
+	@param boardCount The number of boards per grid size and per check
+*/
+Check::Check(uint64_t seed, int boardCount)
+	: m_random(seed)
+{
+	m_boardCount = std::max(boardCount, 1);
+	m_checkCount = 0;
+	m_failureCount = 0;
+}
+
+/**
+	Draw a board, each cell empty or holding a tile up to the provided exponent with the same probability
+
+	@param size The size of the grid
+	@param maxExponent The biggest exponent drawn
+	@return The cells of the board
+*/
+Check::Cells Check::drawCells(int size, int maxExponent)
+{
+	Cells cells;
+	cells.size = size;
+
+	for (int i = 0; i < size * size; i++) {
+		cells.exponents[i] = m_random.nextInt(maxExponent + 1);
+	}
+
+	return cells;
+}
+
+/**
+	Build the packed board of plain cells, one cell at a time
+
+	@param cells The cells
+	@return The board
+*/
+Board Check::toBoard(const Cells& cells)
+{
+	Board board(cells.size);
+
+	for (int y = 0; y < cells.size; y++) {
+		for (int x = 0; x < cells.size; x++) {
+			board.setExponent(x, y, cells.exponents[y * cells.size + x]);
+		}
+	}
+
+	return board;
+}
+
+/**
+	Lay out a weight file byte by byte, the way WeightFile::write does
+
+	@param header The header
+	@param weights The weights, as many as the header says
+	@return The bytes of the file
+*/
+std::vector<char> Check::toBytes(const WeightFile::Header& header, const std::vector<float>& weights)
+{
+	std::vector<char> bytes((size_t)header.dataOffset + weights.size() * sizeof(float), 0);
+
+	memcpy(bytes.data(), &header, sizeof(header));
+	memcpy(bytes.data() + header.dataOffset, weights.data(), weights.size() * sizeof(float));
+
+	return bytes;
+}
+
+/**
+	@param path The path of the file
+	@param bytes The whole content of the file
+	@return If the file has been written
+*/
+bool Check::writeBytes(const std::string& path, const std::vector<char>& bytes)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	file.write(bytes.data(), (std::streamsize)bytes.size());
+
+	return (bool)file;
+}
+
+/**
+	Slide the cells the way the game always has, cell by cell : the tiles of each line are gathered
+	towards the side of the move, then equal neighbours merge by pairs from that side
+
+	@param cells The cells to slide
+	@param dir The direction of the move
+	@return The score gained by the merges
+*/
+int Check::slideReference(Cells* cells, int dir)
+{
+	int size = cells->size;
+	int score = 0;
+
+	for (int line = 0; line < size; line++) {
+		std::vector<int> cellIndices;
+		std::vector<int> tiles;
+		std::vector<int> merged;
+
+		// Cells of the line, starting from the side the tiles slide to
+		for (int i = 0; i < size; i++) {
+			int along = (dir == DIR_RIGHT || dir == DIR_DOWN) ? size - 1 - i : i;
+			int index = (dir == DIR_UP || dir == DIR_DOWN) ? along * size + line : line * size + along;
+
+			cellIndices.push_back(index);
+
+			if (cells->exponents[index] != EMPTY_EXPONENT) {
+				tiles.push_back(cells->exponents[index]);
+			}
+		}
+
+		for (size_t i = 0; i < tiles.size(); i++) {
+			if (i + 1 < tiles.size() && tiles[i] == tiles[i + 1] && tiles[i] < MAX_EXPONENT) {
+				merged.push_back(tiles[i] + 1);
+				score += 1 << (tiles[i] + 1);
+				++i;
+			}
+			else {
+				merged.push_back(tiles[i]);
+			}
+		}
+
+		for (int i = 0; i < size; i++) {
+			cells->exponents[cellIndices[i]] = i < (int)merged.size() ? merged[i] : EMPTY_EXPONENT;
+		}
+	}
+
+	return score;
+}
+
+/**
+	Map the cells by one of the 8 symmetries of the square, cell by cell
+
+	@param cells The cells to map
+	@param symmetry 1 flips horizontally, 2 flips vertically, 4 transposes first, and they combine
+	@return The mapped cells
+*/
+Check::Cells Check::symmetryReference(const Cells& cells, int symmetry)
+{
+	int size = cells.size;
+	Cells mapped;
+
+	mapped.size = size;
+
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			int sourceX = (symmetry & 1) ? size - 1 - x : x;
+			int sourceY = (symmetry & 2) ? size - 1 - y : y;
+
+			if (symmetry & 4) {
+				std::swap(sourceX, sourceY);
+			}
+
+			mapped.exponents[y * size + x] = cells.exponents[sourceY * size + sourceX];
+		}
+	}
+
+	return mapped;
+}
+
+/**
+	Play the start of a game with the hard AI on a single thread and without time budget, as the simulations do
+
+	@param seed The seed of the game
+	@param moveCount The number of moves to play
+	@return The game
+*/
+Game Check::playHardGame(uint64_t seed, int moveCount)
+{
+	AI* ai = AI::create(AI_HARD, 1, 0);
+	Game game(ai->getGridSize(), seed);
+
+	game.start();
+
+	while (game.isMovePossible() && game.getMoveCount() < moveCount) {
+		int dir = ai->chooseMove(game.getBoard());
+
+		if (dir == DIR_NONE || !game.play(dir)) {
+			break;
+		}
+	}
+
+	delete ai;
+
+	return game;
+}
+
+/**
+	Count a check, and print it if it has failed
+
+	@param condition If the check has passed
+	@param what What has been checked, with the values needed to replay it
+*/
+void Check::expect(bool condition, const std::string& what)
+{
+	++m_checkCount;
+
+	if (condition) {
+		return;
+	}
+
+	if (m_failureCount < MAX_PRINTED_FAILURES) {
+		std::cout << "FAILED : " << what << std::endl;
+	}
+
+	++m_failureCount;
+}
+
+/**
+	Generators : the first outputs of known seeds match the reference ones, so every seeded run stays the same,
+	and nextInt stays within its bound and reaches every value of the small ones
+*/
+void Check::checkRandom()
+{
+	uint64_t state = SPLITMIX_SEED;
+
+	for (size_t i = 0; i < sizeof(SPLITMIX_OUTPUTS) / sizeof(SPLITMIX_OUTPUTS[0]); i++) {
+		expect(Random::splitMix(state) == SPLITMIX_OUTPUTS[i], "splitmix64 output " + std::to_string(i));
+	}
+
+	Random random(0);
+
+	for (size_t i = 0; i < sizeof(XOSHIRO_OUTPUTS) / sizeof(XOSHIRO_OUTPUTS[0]); i++) {
+		expect(random.next() == XOSHIRO_OUTPUTS[i], "xoshiro256** output " + std::to_string(i));
+	}
+
+	Random seeded(2048);
+
+	for (size_t i = 0; i < sizeof(NEXT_INT_OUTPUTS) / sizeof(NEXT_INT_OUTPUTS[0]); i++) {
+		expect(seeded.nextInt(10) == NEXT_INT_OUTPUTS[i], "nextInt output " + std::to_string(i));
+	}
+
+	for (int bound : NEXT_INT_BOUNDS) {
+		std::vector<bool> isDrawn(bound <= NEXT_INT_MAX_FULL_BOUND ? bound : 0, false);
+		bool isInBounds = true;
+
+		for (int i = 0; i < NEXT_INT_DRAW_COUNT; i++) {
+			int value = m_random.nextInt(bound);
+
+			isInBounds = isInBounds && value >= 0 && value < bound;
+
+			if (value >= 0 && value < (int)isDrawn.size()) {
+				isDrawn[value] = true;
+			}
+		}
+
+		expect(isInBounds, "nextInt(" + std::to_string(bound) + ") : bounds");
+
+		if (bound <= NEXT_INT_MAX_FULL_BOUND) {
+			expect(std::find(isDrawn.begin(), isDrawn.end(), false) == isDrawn.end(),
+				"nextInt(" + std::to_string(bound) + ") : every value");
+		}
+	}
+}
+
+/**
+	Packed board : every cell reads back as written, and the queries agree with the plain cells
+*/
+void Check::checkBoard()
+{
+	for (int exponent = EMPTY_EXPONENT; exponent <= MAX_EXPONENT; exponent++) {
+		expect(Board::toExponent(Board::toValue(exponent)) == exponent, "value of exponent " + std::to_string(exponent));
+	}
+
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			Cells cells = drawCells(size, MAX_EXPONENT);
+			Board board = toBoard(cells);
+			std::string name = std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i);
+			int empty = 0;
+			int maxExponent = 0;
+			bool isEqual = true;
+
+			for (int y = 0; y < size; y++) {
+				for (int x = 0; x < size; x++) {
+					int exponent = cells.exponents[y * size + x];
+
+					isEqual = isEqual && board.getExponent(x, y) == exponent
+						&& board.isEmpty(x, y) == (exponent == EMPTY_EXPONENT)
+						&& ((board.getEmptyMask() >> (y * size + x)) & 1) == (exponent == EMPTY_EXPONENT ? 1U : 0U);
+					empty += exponent == EMPTY_EXPONENT ? 1 : 0;
+					maxExponent = std::max(maxExponent, exponent);
+				}
+			}
+
+			expect(isEqual, name + " : cells");
+			expect(board.countEmpty() == empty, name + " : empty count");
+			expect(board.countTiles() == size * size - empty, name + " : tile count");
+			expect(board.getMaxExponent() == maxExponent, name + " : max exponent");
+
+			// Rows written back whole give the same board
+			Board copy(size);
+
+			for (int y = 0; y < size; y++) {
+				copy.setRow(y, board.getRow(y));
+			}
+
+			expect(copy == board, name + " : rows");
+		}
+	}
+}
+
+/**
+	Moves : the table driven moves give the board, score and change of the reference slide,
+	and replaying the trace of a move gives the moved board
+*/
+void Check::checkMoves()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			// Small exponents merge often, big ones reach the tiles that can not merge anymore
+			Cells cells = drawCells(size, i % 2 == 0 ? 4 : MAX_EXPONENT);
+			Board board = toBoard(cells);
+
+			for (int dir = 0; dir < DIR_COUNT; dir++) {
+				std::string name = std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i)
+					+ " direction " + std::to_string(dir);
+				Cells slid = cells;
+				int expectedScore = slideReference(&slid, dir);
+				Board expected = toBoard(slid);
+				Board moved = board;
+				int score = -1;
+				bool isChanged = moved.move(dir, &score);
+
+				expect(moved == expected, name + " : moved board");
+				expect(score == expectedScore, name + " : score");
+				expect(isChanged == (expected != board), name + " : change");
+
+				// Tiles are put where the trace says, merging ones on the tile already there
+				MoveTrace trace(board, dir);
+				Board replayed(size);
+				bool isTraceValid = true;
+
+				for (const MoveTrace::Motion& motion : trace.getMotions()) {
+					int there = replayed.getExponent(motion.toX, motion.toY);
+
+					isTraceValid = isTraceValid && board.getExponent(motion.fromX, motion.fromY) == motion.exponent
+						&& there == (motion.isMerged ? motion.exponent : EMPTY_EXPONENT);
+					replayed.setExponent(motion.toX, motion.toY, motion.isMerged ? motion.exponent + 1 : motion.exponent);
+				}
+
+				expect(isTraceValid && replayed == expected, name + " : trace");
+			}
+		}
+	}
+}
+
+/**
+	Game over : a board has a move left exactly when a reference slide changes it in some direction
+*/
+void Check::checkGameOver()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			// Odd exponents on the cells of one color of a checkerboard and even ones on the other are stuck,
+			// then some boards get a cell equal to its right or lower neighbour, an empty cell,
+			// or a pair of MAX_EXPONENT tiles that stay stuck
+			Cells cells;
+			cells.size = size;
+
+			for (int y = 0; y < size; y++) {
+				for (int x = 0; x < size; x++) {
+					cells.exponents[y * size + x] = 1 + (x + y) % 2 + 2 * m_random.nextInt(7);
+				}
+			}
+
+			int x = m_random.nextInt(size - 1);
+			int y = m_random.nextInt(size - 1);
+			int cell = y * size + x;
+
+			switch (i % 8) {
+			case 1:
+				cells.exponents[cell] = cells.exponents[cell + 1];
+				break;
+			case 3:
+				cells.exponents[cell] = cells.exponents[cell + size];
+				break;
+			case 5:
+				cells.exponents[cell] = MAX_EXPONENT;
+				cells.exponents[cell + size] = MAX_EXPONENT;
+				break;
+			case 7:
+				cells.exponents[cell] = EMPTY_EXPONENT;
+				break;
+			}
+
+			bool hasMove = false;
+
+			for (int dir = 0; dir < DIR_COUNT; dir++) {
+				Cells slid = cells;
+
+				slideReference(&slid, dir);
+				hasMove = hasMove || !std::equal(slid.exponents, slid.exponents + size * size, cells.exponents);
+			}
+
+			expect(toBoard(cells).hasAnyMove() == hasMove,
+				std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i) + " : move left");
+		}
+	}
+}
+
+/**
+	Transposition table : hashes tell boards apart, stored values come back only for searches
+	no deeper and no more likely than the stored one, and the replacement policies keep the right entry
+*/
+void Check::checkTranspositionTable()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			Cells cells = drawCells(size, MAX_EXPONENT);
+			Board board = toBoard(cells);
+			std::string name = std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i);
+			int cell = m_random.nextInt(size * size);
+			Board changed = board;
+
+			changed.setExponent(cell % size, cell / size, (cells.exponents[cell] + 1) % (MAX_EXPONENT + 1));
+
+			Board resized(size == GRID_SIZE_MAX ? GRID_SIZE_MIN : size + 1);
+
+			for (int y = 0; y < std::min(size, resized.getSize()); y++) {
+				resized.setRow(y, board.getRow(y) & ((1U << (4 * resized.getSize())) - 1U));
+			}
+
+			expect(TranspositionTable::hash(board) == TranspositionTable::hash(toBoard(cells)), name + " : same hash");
+			expect(TranspositionTable::hash(board) != TranspositionTable::hash(changed), name + " : hash of another cell");
+			expect(board.getWord(0) != resized.getWord(0) || board.getWord(1) != resized.getWord(1)
+				|| TranspositionTable::hash(board) != TranspositionTable::hash(resized), name + " : hash of another size");
+		}
+	}
+
+	uint64_t key = TranspositionTable::hash(toBoard(drawCells(SIZE_AI_NORMAL, MAX_EXPONENT)));
+	float value = 0.0f;
+
+	// Other boards of the bucket of the key in a small table, enough to fill it and one more
+	uint64_t others[TT_BUCKET_SIZE];
+
+	for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+		others[i] = key ^ ((uint64_t)(i + 1) << 40);
+	}
+
+	TranspositionTable table(10, TT_REPLACE_ALWAYS);
+
+	expect(!table.probe(key, 1, 1.0f, &value), "table : empty");
+
+	table.store(key, 3, 0.25f, 1234.5f);
+	expect(table.probe(key, 3, 0.25f, &value) && value == 1234.5f, "table : same search");
+	expect(table.probe(key, 2, 0.125f, &value) && value == 1234.5f, "table : shallower and less likely search");
+	expect(!table.probe(key, 4, 0.25f, &value), "table : deeper search");
+	expect(!table.probe(key, 3, 0.5f, &value), "table : more likely search");
+	expect(!table.probe(others[0], 1, 0.25f, &value), "table : other board of the bucket");
+
+	for (int i = 0; i < TT_BUCKET_SIZE - 1; i++) {
+		table.store(others[i], 2, 0.25f, (float)i);
+	}
+
+	bool isFilled = table.probe(key, 3, 0.25f, &value) && value == 1234.5f;
+
+	for (int i = 0; i < TT_BUCKET_SIZE - 1; i++) {
+		isFilled = isFilled && table.probe(others[i], 2, 0.25f, &value) && value == (float)i;
+	}
+
+	expect(isFilled, "table : boards sharing a bucket");
+	expect(table.getCollisions() == 0, "table : no collision before the bucket is full");
+
+	// The shallowest entry is replaced, whatever its depth
+	table.store(others[TT_BUCKET_SIZE - 1], 1, 0.25f, 1.0f);
+	expect(table.probe(others[TT_BUCKET_SIZE - 1], 1, 0.25f, &value) && value == 1.0f
+		&& table.probe(key, 3, 0.25f, &value) && !table.probe(others[0], 2, 0.25f, &value), "table : always replaced");
+	expect(table.getCollisions() == 1, "table : collision count");
+
+	table.clear();
+	expect(!table.probe(key, 1, 0.25f, &value), "table : cleared");
+
+	TranspositionTable deeper(10, TT_REPLACE_DEEPER);
+
+	deeper.store(key, 3, 0.25f, 1234.5f);
+
+	for (int i = 0; i < TT_BUCKET_SIZE - 1; i++) {
+		deeper.store(others[i], 3, 0.25f, (float)i);
+	}
+
+	deeper.store(others[TT_BUCKET_SIZE - 1], 2, 0.25f, 1.0f);
+	expect(deeper.probe(key, 3, 0.25f, &value) && !deeper.probe(others[TT_BUCKET_SIZE - 1], 2, 0.25f, &value),
+		"table : kept deeper");
+
+	deeper.store(others[TT_BUCKET_SIZE - 1], 4, 0.25f, 1.0f);
+	expect(deeper.probe(others[TT_BUCKET_SIZE - 1], 4, 0.25f, &value), "table : replaced by deeper");
+}
+
+/**
+	Symmetries : the flips and the transposition match the reference ones, and the 8 symmetric boards
+	share one canonical board, the smallest of them
+*/
+void Check::checkSymmetries()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			Cells cells = drawCells(size, MAX_EXPONENT);
+			Board board = toBoard(cells);
+			Board canonical = board.canonicalize();
+			std::string name = std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i);
+			Board smallest = board;
+
+			expect(board.flipHorizontal() == toBoard(symmetryReference(cells, 1)), name + " : horizontal flip");
+			expect(board.flipVertical() == toBoard(symmetryReference(cells, 2)), name + " : vertical flip");
+			expect(board.transpose() == toBoard(symmetryReference(cells, 4)), name + " : transposition");
+
+			for (int symmetry = 0; symmetry < 8; symmetry++) {
+				Board mapped = toBoard(symmetryReference(cells, symmetry));
+
+				expect(mapped.canonicalize() == canonical, name + " : canonical board of symmetry " + std::to_string(symmetry));
+
+				if (mapped.getWord(1) < smallest.getWord(1)
+					|| (mapped.getWord(1) == smallest.getWord(1) && mapped.getWord(0) < smallest.getWord(0))) {
+					smallest = mapped;
+				}
+			}
+
+			expect(canonical == smallest, name + " : smallest symmetric board");
+		}
+	}
+}
+
+/**
+	Weight file : the weights written come back whole, and a file of another version, machine, evaluator,
+	grid or layout, or a truncated one, is refused while the weights already open stay in use
+*/
+void Check::checkWeightFile()
+{
+	const uint64_t layout = 0x2048204820482048ULL;
+	std::vector<float> weights(1000);
+
+	for (float& weight : weights) {
+		weight = (float)m_random.nextInt(1 << 20) / 7.0f;
+	}
+
+	WeightFile::Header expected = WeightFile::createHeader(WEIGHT_KIND_NTUPLE, SIZE_AI_NORMAL, layout, weights.size());
+	WeightFile file;
+
+	expect(WeightFile::write(WEIGHT_FILE_PATH, expected, weights.data()), "weight file : written");
+	expect(!std::ifstream(WEIGHT_FILE_PATH + ".tmp"), "weight file : temporary file removed");
+	expect(file.open(WEIGHT_FILE_PATH, expected) && file.getError().empty(), "weight file : opened");
+
+	const float* opened = file.getWeights();
+
+	expect(opened && memcmp(opened, weights.data(), weights.size() * sizeof(float)) == 0, "weight file : weights");
+
+	struct Refusal
+	{
+		std::string name;
+		std::vector<char> bytes;
+		std::string error;
+	};
+
+	std::vector<Refusal> refusals;
+	WeightFile::Header header = expected;
+
+	header.magic[0] = 'X';
+	refusals.push_back({ "damaged magic", toBytes(header, weights), "not a weight file" });
+
+	header = expected;
+	header.byteOrder = 0x04030201;
+	refusals.push_back({ "other byte order", toBytes(header, weights), "written on a machine of another endianness" });
+
+	header = expected;
+	header.version = WEIGHT_FILE_VERSION + 1;
+	refusals.push_back({ "other version", toBytes(header, weights),
+		"version " + std::to_string(WEIGHT_FILE_VERSION + 1) + ", version " + std::to_string(WEIGHT_FILE_VERSION) + " expected" });
+
+	header = expected;
+	header.kind = WEIGHT_KIND_NTUPLE + 1;
+	refusals.push_back({ "other kind", toBytes(header, weights), "weights of another kind of evaluator" });
+
+	header = expected;
+	header.gridSize = SIZE_AI_HARD;
+	refusals.push_back({ "other grid size", toBytes(header, weights), "weights of a 5x5 grid, 4x4 expected" });
+
+	header = expected;
+	header.layout = layout + 1;
+	refusals.push_back({ "other layout", toBytes(header, weights), "weights of another layout of the evaluator" });
+
+	header = expected;
+	header.weightCount = weights.size() - 1;
+	refusals.push_back({ "other weight count", toBytes(header, std::vector<float>(weights.begin(), weights.end() - 1)),
+		"weights of another layout of the evaluator" });
+
+	std::vector<char> truncated = toBytes(expected, weights);
+	truncated.resize(truncated.size() - sizeof(float));
+	refusals.push_back({ "truncated", truncated, "truncated or damaged file" });
+
+	refusals.push_back({ "headerless", std::vector<char>(sizeof(WeightFile::Header) / 2, 0), "not a weight file" });
+
+	for (const Refusal& refusal : refusals) {
+		std::string name = refusal.name + " weight file";
+
+		expect(writeBytes(BAD_WEIGHT_FILE_PATH, refusal.bytes), name + " : written");
+		expect(!file.open(BAD_WEIGHT_FILE_PATH, expected), name + " : refused");
+		expect(file.getError() == refusal.error, name + " : error \"" + file.getError() + "\"");
+		expect(file.getWeights() == opened && memcmp(opened, weights.data(), weights.size() * sizeof(float)) == 0,
+			name + " : weights kept");
+	}
+
+	std::remove(BAD_WEIGHT_FILE_PATH.c_str());
+
+	expect(!file.open(BAD_WEIGHT_FILE_PATH, expected) && file.getError() == "cannot open the file", "missing weight file : refused");
+	expect(file.getWeights() == opened, "missing weight file : weights kept");
+
+	// The same file opened again replaces the mapping
+	expect(file.open(WEIGHT_FILE_PATH, expected) && file.getError().empty(), "weight file : opened again");
+
+	file.close();
+	expect(file.getWeights() == nullptr, "weight file : closed");
+
+	std::remove(WEIGHT_FILE_PATH.c_str());
+}
+
+/**
+	Hard game : a seeded game played twice by the hard AI gives the same moves and score,
+	whatever the load of the machine
+*/
+void Check::checkHardGame()
+{
+	uint64_t seed = m_random.next();
+	Game first = playHardGame(seed, HARD_GAME_MOVE_COUNT);
+	Game second = playHardGame(seed, HARD_GAME_MOVE_COUNT);
+	std::string name = "hard game of seed " + std::to_string(seed);
+
+	expect(first.getMoveCount() == second.getMoveCount(), name + " : move count");
+	expect(first.getScore() == second.getScore(), name + " : score " + std::to_string(first.getScore())
+		+ " then " + std::to_string(second.getScore()));
+	expect(first.getBoard() == second.getBoard(), name + " : board");
+}
+
+/**
+	Searches : bounded by their playout count or their depth rather than by the clock, the searches give
+	the same move on one thread and on several, and the expectimax search avoids a certain game over
+*/
+void Check::checkSearches()
+{
+	ThreadPool single(1);
+	ThreadPool parallel(SEARCH_THREAD_COUNT);
+
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		HeuristicEvaluator heuristic(size, HeuristicEvaluator::Weights());
+		MonteCarlo monteCarlo(SEARCH_PLAYOUT_COUNT, 0);
+		Expectimax expectimax(SEARCH_DEPTH, 0, AI_HARD_MIN_PROBABILITY, nullptr);
+
+		expectimax.setEvaluator(&heuristic);
+
+		for (int i = 0; i < SEARCH_BOARD_COUNT; i++) {
+			Board board = toBoard(drawCells(size, MAX_EXPONENT / 2));
+			std::string name = std::to_string(size) + "x" + std::to_string(size) + " search board " + std::to_string(i);
+
+			// The batch seeds come from the board, whatever thread plays them
+			monteCarlo.setThreadPool(nullptr);
+			int sequentialDir = monteCarlo.chooseMove(board);
+
+			monteCarlo.setThreadPool(&single);
+			int singleDir = monteCarlo.chooseMove(board);
+
+			monteCarlo.setThreadPool(&parallel);
+			int parallelDir = monteCarlo.chooseMove(board);
+
+			expect(singleDir == sequentialDir && parallelDir == sequentialDir, name + " : monte carlo move "
+				+ std::to_string(sequentialDir) + ", " + std::to_string(singleDir) + ", " + std::to_string(parallelDir));
+
+			// Without table and time budget, the parallel root searches the same tree as the sequential one
+			expectimax.setThreadPool(nullptr);
+			sequentialDir = expectimax.chooseMove(board);
+
+			expectimax.setThreadPool(&parallel);
+			parallelDir = expectimax.chooseMove(board);
+
+			expect(parallelDir == sequentialDir, name + " : expectimax move "
+				+ std::to_string(sequentialDir) + ", " + std::to_string(parallelDir));
+		}
+	}
+
+	// Sliding right loses whatever spawns, sliding down merges the 2s : down is the only move worth playing,
+	// even for an evaluator valuing the full board right leads to as much as any other
+	// 2  8  2
+	// 8  2  8
+	// 32 16 .
+	Cells cells = { SIZE_AI_EASY, { 1, 3, 1, 3, 1, 3, 5, 4, EMPTY_EXPONENT } };
+	Board board = toBoard(cells);
+	HeuristicEvaluator heuristic(SIZE_AI_EASY, HeuristicEvaluator::Weights());
+	TileCountEvaluator tileCount;
+
+	for (int depth = 1; depth <= SEARCH_DEPTH + 1; depth++) {
+		Expectimax expectimax(depth, 0, AI_HARD_MIN_PROBABILITY, nullptr);
+
+		expectimax.setEvaluator(&heuristic);
+		expect(expectimax.chooseMove(board) == DIR_DOWN, "expectimax of depth " + std::to_string(depth) + " : known move");
+
+		expectimax.setEvaluator(&tileCount);
+		expect(expectimax.chooseMove(board) == DIR_DOWN, "expectimax of depth " + std::to_string(depth)
+			+ " : known move, valued by tile count");
+	}
+
+	// Stuck, no move to choose
+	Cells stuck = { SIZE_AI_EASY, { 1, 3, 1, 3, 1, 3, 5, 4, 5 } };
+	Expectimax expectimax(SEARCH_DEPTH, 0, AI_HARD_MIN_PROBABILITY, nullptr);
+
+	expectimax.setEvaluator(&heuristic);
+	expect(expectimax.chooseMove(toBoard(stuck)) == DIR_NONE, "expectimax : no move");
+}
+
+/**
+	Bit selection : the k-th set bit of random masks, with and without pdep, is the one a plain loop finds
+*/
+void Check::checkSelectBit()
+{
+	for (int i = 0; i < m_boardCount; i++) {
+		// Sparse masks as well, like the empty cells of a crowded board
+		uint32_t mask = (uint32_t)m_random.next();
+
+		if (i % 2 == 1) {
+			mask &= (uint32_t)m_random.next() & (uint32_t)m_random.next();
+		}
+
+		int k = 0;
+		bool isEqual = true;
+
+		for (int bit = 0; bit < 32; bit++) {
+			if (!(mask & (1U << bit))) {
+				continue;
+			}
+
+			isEqual = isEqual && selectBit(mask, k) == bit && selectBitPortable(mask, k) == bit;
+			++k;
+		}
+
+		expect(isEqual, "selected bits of mask " + std::to_string(mask));
+	}
+}
+
+/**
+	Spawns : a new 2 or 4 lands on an empty cell and nowhere else,
+	and spawns repeated on the same board reach every empty cell and both values
+*/
+void Check::checkSpawns()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		for (int i = 0; i < m_boardCount; i++) {
+			Cells cells = drawCells(size, MAX_EXPONENT);
+			Board board = toBoard(cells);
+			std::string name = std::to_string(size) + "x" + std::to_string(size) + " board " + std::to_string(i);
+			Game game(size, m_random.next());
+
+			game.setBoard(board);
+
+			int index = game.spawnTile();
+			int empty = board.countEmpty();
+
+			if (empty == 0) {
+				expect(index == -1 && game.getBoard() == board, name + " : no spawn on a full board");
+				continue;
+			}
+
+			Cells spawned = cells;
+			bool isEmptyCell = index >= 0 && index < size * size && cells.exponents[index] == EMPTY_EXPONENT;
+
+			if (isEmptyCell) {
+				spawned.exponents[index] = game.getBoard().getExponent(index % size, index / size);
+			}
+
+			expect(isEmptyCell && (spawned.exponents[index] == 1 || spawned.exponents[index] == 2)
+				&& game.getBoard() == toBoard(spawned), name + " : spawn on cell " + std::to_string(index));
+
+			if (i >= SPAWN_BOARD_COUNT) {
+				continue;
+			}
+
+			std::vector<int> counts(size * size, 0);
+			bool isTwoSpawned = false;
+			bool isFourSpawned = false;
+
+			for (int j = 0; j < SPAWNS_PER_EMPTY_CELL * empty; j++) {
+				game.setBoard(board);
+				index = game.spawnTile();
+				++counts[index];
+				isTwoSpawned = isTwoSpawned || game.getBoard().getExponent(index % size, index / size) == 1;
+				isFourSpawned = isFourSpawned || game.getBoard().getExponent(index % size, index / size) == 2;
+			}
+
+			bool isReached = true;
+
+			for (int cell = 0; cell < size * size; cell++) {
+				isReached = isReached && (counts[cell] > 0) == (cells.exponents[cell] == EMPTY_EXPONENT);
+			}
+
+			expect(isReached, name + " : spawns on every empty cell");
+			expect(isTwoSpawned && isFourSpawned, name + " : spawns of both values");
+		}
+	}
+}
+
+/**
+	Check an evaluator gives the same value to the 8 symmetries of each board
+
+	@param evaluator The evaluator
+	@param boards The boards, of the grid of the evaluator
+	@param name The name of the evaluator
+*/
+void Check::checkSymmetricValues(const Evaluator& evaluator, const std::vector<Cells>& boards, const std::string& name)
+{
+	for (size_t i = 0; i < boards.size(); i++) {
+		float value = evaluator.evaluate(toBoard(boards[i]));
+		bool isEqual = true;
+
+		for (int symmetry = 1; symmetry < 8; symmetry++) {
+			float mapped = evaluator.evaluate(toBoard(symmetryReference(boards[i], symmetry)));
+
+			isEqual = isEqual && std::fabs(mapped - value) <= EVALUATOR_TOLERANCE * std::max(1.0f, std::fabs(value));
+		}
+
+		expect(isEqual, name + " board " + std::to_string(i) + " : same value in every symmetry");
+	}
+}
+
+/**
+	Evaluators : the searches cache the values of canonical boards, which is only right if every evaluator
+	values a board and its rotations and reflections the same
+*/
+void Check::checkEvaluators()
+{
+	for (int size = GRID_SIZE_MIN; size <= GRID_SIZE_MAX; size++) {
+		std::string grid = std::to_string(size) + "x" + std::to_string(size);
+		std::vector<Cells> boards;
+
+		for (int i = 0; i < EVALUATOR_BOARD_COUNT; i++) {
+			boards.push_back(drawCells(size, MAX_EXPONENT / 2));
+		}
+
+		checkSymmetricValues(HeuristicEvaluator(size, HeuristicEvaluator::Weights()), boards, grid + " heuristic");
+
+		// Every term weighted, some not by default
+		HeuristicEvaluator::Weights weights;
+
+		weights.base = (float)m_random.nextInt(1000);
+		weights.empty = (float)m_random.nextInt(1000);
+		weights.merges = (float)m_random.nextInt(1000);
+		weights.monotonicity = (float)m_random.nextInt(100);
+		weights.monotonicityPower = 1.0f + m_random.nextInt(4);
+		weights.smoothness = (float)m_random.nextInt(100);
+		weights.lineEnd = (float)m_random.nextInt(100);
+		weights.sum = (float)m_random.nextInt(100);
+		weights.sumPower = 1.0f + m_random.nextInt(4);
+
+		checkSymmetricValues(HeuristicEvaluator(size, weights), boards, grid + " weighted heuristic");
+
+		// Weights written through the boards themselves, the others staying 0
+		NTupleNetwork network(size);
+
+		network.makeWritable();
+
+		for (size_t i = 0; i < boards.size(); i++) {
+			network.update(toBoard(boards[i]), (float)m_random.nextInt(1000) - 500.0f);
+		}
+
+		checkSymmetricValues(network, boards, grid + " n-tuple network");
+	}
+}
+
+/**
+	Run every check and print a summary
+
+	@return If every check has passed
+*/
+bool Check::run()
+{
+	checkRandom();
+	checkBoard();
+	checkMoves();
+	checkGameOver();
+	checkTranspositionTable();
+	checkSymmetries();
+	checkEvaluators();
+	checkWeightFile();
+	checkHardGame();
+	checkSearches();
+	checkSelectBit();
+	checkSpawns();
+
+	std::cout << m_checkCount - m_failureCount << " / " << m_checkCount << " checks passed" << std::endl;
+
+	return m_failureCount == 0;
+}
@@ -0,0 +1,19 @@
+#include "pch.h"
+#include "Check/Check.h"
+#include "Core/Options.h"
+
+/**
+	Check the game core kernels on --boards boards per grid size drawn from --seed
+	Exits with 1 if any check fails, so the build can run it as a test
+*/
+int main(int argc, char** argv)
+{
+	Options options(argc, argv);
+
+	Check check(
+		options.getUInt64("seed", 2048),
+		options.getInt("boards", 10000)
+	);
+
+	return check.run() ? 0 : 1;
+}
@@ -0,0 +1,519 @@
+#include "pch.h"
+#include "Core/Board.h"
+#include "Core/MoveTable.h"
+#include "Core/Bits.h"
+
+#include <iostream>
+
+/**
+	Default constructor, builds an empty board of the normal size
+*/
+Board::Board()
+	: Board(SIZE_AI_NORMAL)
+{
+}
+
+/**
+	Build an empty board
+
+	@param size The number of cells per line
+*/
+Board::Board(int size)
+{
+	m_words[0] = 0;
+	m_words[1] = 0;
+	m_size = size;
+}
+
+/**
+	Convert a tile value into the exponent stored in a cell
+
+	@param value The tile value (GHOST_VAL or 0 for an empty cell)
+	@return The log2 of the value, EMPTY_EXPONENT for an empty cell
+*/
+int Board::toExponent(int value)
+{
+	if (value <= 0) {
+		return EMPTY_EXPONENT;
+	}
+
+	int exponent = 0;
+
+	while (value > 1) {
+		value >>= 1;
+		++exponent;
+	}
+
+	return exponent;
+}
+
+/**
+	Convert a cell exponent into the tile value
+
+	@param exponent The exponent stored in the cell
+	@return The tile value, 0 for an empty cell
+*/
+int Board::toValue(int exponent)
+{
+	if (exponent == EMPTY_EXPONENT) {
+		return 0;
+	}
+
+	return 1 << exponent;
+}
+
+/**
+	Slide every line of the board in the provided direction
+	Each row is resolved by a single lookup, columns are turned into rows by transposing the board
+	The 3x3 and 4x4 boards read their rows straight from their single word
+
+	@param dir The direction to move the tiles in
+	@param score Where to store the score gained by the merges (can be null)
+	@return If the board has changed
+*/
+bool Board::move(int dir, int* score)
+{
+	const MoveTable& table = MoveTable::get(m_size);
+	bool isVertical = (dir == DIR_UP || dir == DIR_DOWN);
+	bool isReversed = (dir == DIR_RIGHT || dir == DIR_DOWN);
+	Board lines = isVertical ? transpose() : *this;
+	Board moved(m_size);
+	uint32_t gained = 0;
+
+	if (m_size <= SIZE_AI_NORMAL) {
+		uint64_t word = lines.m_words[0];
+		uint64_t result = 0;
+		int width = 4 * m_size;
+		uint32_t mask = getRowMask();
+
+		for (int shift = 0; shift < width * m_size; shift += width) {
+			uint32_t row = (uint32_t)(word >> shift) & mask;
+
+			result |= (uint64_t)table.slide(row, isReversed) << shift;
+			gained += table.getScore(row);
+		}
+
+		moved.m_words[0] = result;
+	}
+	else {
+		uint32_t rows[GRID_SIZE_MAX];
+
+		lines.unpackRows(rows);
+
+		for (int y = 0; y < m_size; y++) {
+			gained += table.getScore(rows[y]);
+			rows[y] = table.slide(rows[y], isReversed);
+		}
+
+		moved.packRows(rows);
+	}
+
+	if (isVertical) {
+		moved = moved.transpose();
+	}
+
+	if (score) {
+		*score = (int)gained;
+	}
+
+	bool isChanged = moved != *this;
+	*this = moved;
+
+	return isChanged;
+}
+
+/**
+	Slide every line of the board in the provided direction
+
+	@param dir The direction to move the tiles in
+	@return If the board has changed
+*/
+bool Board::move(int dir)
+{
+	return move(dir, nullptr);
+}
+
+/**
+	Get the board mirrored along its main diagonal
+	The 3x3 and 4x4 boards fit in a single word so they are transposed with bit tricks
+
+	@return The transposed board
+*/
+Board Board::transpose() const
+{
+	Board transposed(m_size);
+
+	if (m_size == SIZE_AI_EASY) {
+		// Cells 1 and 5 swap with cells 3 and 7 two cells further, cell 2 with cell 6 four cells further
+		uint64_t x = m_words[0];
+		uint64_t kept = x & 0x0000000F000F000FULL;
+		uint64_t near = ((x & 0x0000000000F000F0ULL) << 8) | ((x >> 8) & 0x0000000000F000F0ULL);
+		uint64_t far = ((x & 0x0000000000000F00ULL) << 16) | ((x >> 16) & 0x0000000000000F00ULL);
+
+		transposed.m_words[0] = kept | near | far;
+
+		return transposed;
+	}
+
+	if (m_size == SIZE_AI_NORMAL) {
+		uint64_t x = m_words[0];
+		uint64_t a1 = x & 0xF0F00F0FF0F00F0FULL;
+		uint64_t a2 = x & 0x0000F0F00000F0F0ULL;
+		uint64_t a3 = x & 0x0F0F00000F0F0000ULL;
+		uint64_t a = a1 | (a2 << 12) | (a3 >> 12);
+		uint64_t b1 = a & 0xFF00FF0000FF00FFULL;
+		uint64_t b2 = a & 0x00FF00FF00000000ULL;
+		uint64_t b3 = a & 0x00000000FF00FF00ULL;
+
+		transposed.m_words[0] = b1 | (b2 >> 24) | (b3 << 24);
+
+		return transposed;
+	}
+
+	// The 5x5 board spreads each row over the transposed words : its first three cells start the three rows
+	// of the first word, its last two the two rows of the second one, all of them shifted by the row index
+	uint32_t rows[SIZE_AI_HARD];
+
+	unpackRows(rows);
+
+	for (int y = 0; y < SIZE_AI_HARD; y++) {
+		uint64_t row = rows[y];
+
+		transposed.m_words[0] |= ((row & 0xF) | ((row & 0xF0) << 16) | ((row & 0xF00) << 32)) << (4 * y);
+		transposed.m_words[1] |= (((row >> 12) & 0xF) | ((row & 0xF0000) << 4)) << (4 * y);
+	}
+
+	return transposed;
+}
+
+/**
+	Get the board mirrored left to right
+	The 4x4 board reverses the cells of its four rows at once with bit tricks
+
+	@return The mirrored board
+*/
+Board Board::flipHorizontal() const
+{
+	Board flipped(m_size);
+
+	if (m_size == SIZE_AI_NORMAL) {
+		uint64_t x = m_words[0];
+
+		x = ((x & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+		x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+		flipped.m_words[0] = x;
+
+		return flipped;
+	}
+
+	// Other sizes reverse the 8 cells a 32-bit row could hold, then drop the unused ones
+	for (int y = 0; y < m_size; y++) {
+		uint32_t row = getRow(y);
+
+		row = ((row & 0x0F0F0F0FU) << 4) | ((row >> 4) & 0x0F0F0F0FU);
+		row = (row << 24) | ((row & 0xFF00U) << 8) | ((row >> 8) & 0xFF00U) | (row >> 24);
+		flipped.setRow(y, row >> (4 * (8 - m_size)));
+	}
+
+	return flipped;
+}
+
+/**
+	Get the board mirrored top to bottom
+	The 4x4 board swaps its rows at once with bit tricks
+
+	@return The mirrored board
+*/
+Board Board::flipVertical() const
+{
+	Board flipped(m_size);
+
+	if (m_size == SIZE_AI_NORMAL) {
+		uint64_t x = m_words[0];
+
+		x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+		flipped.m_words[0] = (x << 32) | (x >> 32);
+
+		return flipped;
+	}
+
+	for (int y = 0; y < m_size; y++) {
+		flipped.setRow(m_size - 1 - y, getRow(y));
+	}
+
+	return flipped;
+}
+
+/**
+	Get the smallest of the 8 boards equivalent by rotation or reflection
+	Equivalent boards are worth the same to a search, so keyed by their canonical board they share their cache entries
+	The 4x4 board compares the 8 boards built with bit tricks,
+	other sizes compare the rows of the 8 boards before building only the smallest one
+
+	@return The canonical board
+*/
+Board Board::canonicalize() const
+{
+	if (m_size == SIZE_AI_NORMAL) {
+		Board mirrored = flipHorizontal();
+		Board transposed = transpose();
+		Board transposedMirrored = transposed.flipHorizontal();
+		uint64_t candidates[8] = {
+			m_words[0],
+			mirrored.m_words[0],
+			flipVertical().m_words[0],
+			mirrored.flipVertical().m_words[0],
+			transposed.m_words[0],
+			transposedMirrored.m_words[0],
+			transposed.flipVertical().m_words[0],
+			transposedMirrored.flipVertical().m_words[0]
+		};
+		Board canonical(m_size);
+
+		canonical.m_words[0] = candidates[0];
+
+		for (int i = 1; i < 8; i++) {
+			if (candidates[i] < canonical.m_words[0]) {
+				canonical.m_words[0] = candidates[i];
+			}
+		}
+
+		return canonical;
+	}
+
+	// Rows, mirrored rows, columns and mirrored columns, each read top to bottom or bottom to top
+	uint32_t lines[4][GRID_SIZE_MAX];
+	Board transposed = transpose();
+	Board mirrored = flipHorizontal();
+	Board transposedMirrored = transposed.flipHorizontal();
+
+	for (int y = 0; y < m_size; y++) {
+		lines[0][y] = getRow(y);
+		lines[1][y] = mirrored.getRow(y);
+		lines[2][y] = transposed.getRow(y);
+		lines[3][y] = transposedMirrored.getRow(y);
+	}
+
+	// The last row is the most significant one of the packed words
+	int last = m_size - 1;
+	int bestLines = 0;
+	bool bestReversed = false;
+
+	for (int i = 0; i < 4; i++) {
+		for (int reversed = 0; reversed < 2; reversed++) {
+			for (int y = last; y >= 0; y--) {
+				uint32_t row = lines[i][reversed ? last - y : y];
+				uint32_t bestRow = lines[bestLines][bestReversed ? last - y : y];
+
+				if (row != bestRow) {
+					if (row < bestRow) {
+						bestLines = i;
+						bestReversed = reversed != 0;
+					}
+
+					break;
+				}
+			}
+		}
+	}
+
+	Board canonical(m_size);
+
+	for (int y = 0; y < m_size; y++) {
+		canonical.setRow(y, lines[bestLines][bestReversed ? last - y : y]);
+	}
+
+	return canonical;
+}
+
+/**
+	Get the number of empty cells on the board
+
+	@return The number of empty cells
+*/
+int Board::countEmpty() const
+{
+	uint32_t cells = 0x88888888U & getRowMask();
+	int count = 0;
+
+	for (int y = 0; y < m_size; y++) {
+		count += popCount(getZeroCells(getRow(y)) & cells);
+	}
+
+	return count;
+}
+
+/**
+	Get the empty cells of the board as a bitmask
+	Each row's zero flags are gathered into size consecutive bits, without looking at the cells one by one
+
+	@return One bit per empty cell, the cell (x, y) being bit y * size + x
+*/
+uint32_t Board::getEmptyMask() const
+{
+	uint32_t cells = 0x88888888U & getRowMask();
+	uint32_t mask = 0;
+
+	for (int y = 0; y < m_size; y++) {
+		uint32_t flags = (getZeroCells(getRow(y)) & cells) >> 3; // bit 4x set for each empty cell
+		uint32_t bits = flags & 0x1U;
+
+		bits |= (flags >> 3) & 0x2U;
+		bits |= (flags >> 6) & 0x4U;
+		bits |= (flags >> 9) & 0x8U;
+		bits |= (flags >> 12) & 0x10U;
+		mask |= bits << (y * m_size);
+	}
+
+	return mask;
+}
+
+/**
+	Get the number of valued tiles on the board
+
+	@return The number of valued tiles
+*/
+int Board::countTiles() const
+{
+	return m_size * m_size - countEmpty();
+}
+
+/**
+	Get the highest exponent stored on the board
+
+	@return The highest exponent, EMPTY_EXPONENT if the board is empty
+*/
+int Board::getMaxExponent() const
+{
+	int max = EMPTY_EXPONENT;
+
+	for (int y = 0; y < m_size; y++) {
+		for (int x = 0; x < m_size; x++) {
+			if (getExponent(x, y) > max) {
+				max = getExponent(x, y);
+			}
+		}
+	}
+
+	return max;
+}
+
+/**
+	Check if the cell at the provided coordinates is empty
+
+	@param x The x coordinate
+	@param y The y coordinate
+	@return If the cell is empty
+*/
+bool Board::isEmpty(int x, int y) const
+{
+	return getExponent(x, y) == EMPTY_EXPONENT;
+}
+
+/**
+	Flag each cell of a packed row holding a zero
+	Unlike the usual borrow-based trick the result is exact for every cell
+
+	@param row The packed row
+	@return 0x8 in each zero cell, 0 elsewhere
+*/
+uint32_t Board::getZeroCells(uint32_t row)
+{
+	return ~(((row & 0x77777777U) + 0x77777777U) | row | 0x77777777U);
+}
+
+/**
+	Check if at least one direction would change the board
+	Pure query working on the packed rows : a move exists as soon as a cell is empty
+	or two neighbour cells hold the same mergeable exponent
+
+	@return If a move is doable by the player
+*/
+bool Board::hasAnyMove() const
+{
+	uint32_t cells = 0x88888888U & getRowMask(); // one flag per cell of a row
+	uint32_t pairs = cells >> 4; // one flag per horizontal pair of a row
+
+	for (int y = 0; y < m_size; y++) {
+		uint32_t row = getRow(y);
+		uint32_t mergeable = ~getZeroCells(~row & getRowMask()); // MAX_EXPONENT tiles never merge
+
+		// An empty cell
+		if (getZeroCells(row) & cells) {
+			return true;
+		}
+
+		// Two equal tiles on the row
+		if (getZeroCells(row ^ (row >> 4)) & pairs & mergeable) {
+			return true;
+		}
+
+		// Two equal tiles on the column
+		if (y < m_size - 1 && (getZeroCells(row ^ getRow(y + 1)) & cells & mergeable)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+	Get the tile value at the provided coordinates
+
+	@param x The x coordinate
+	@param y The y coordinate
+	@return The tile value, 0 for an empty cell
+*/
+int Board::getValue(int x, int y) const
+{
+	return toValue(getExponent(x, y));
+}
+
+/**
+	Get one of the raw packed words of the board
+
+	@param index The index of the word (0 or 1)
+	@return The packed word
+*/
+uint64_t Board::getWord(int index) const
+{
+	return m_words[index];
+}
+
+/**
+	Set the tile value at the provided coordinates
+
+	@param x The x coordinate
+	@param y The y coordinate
+	@param value The tile value (GHOST_VAL or 0 for an empty cell)
+*/
+void Board::setValue(int x, int y, int value)
+{
+	setExponent(x, y, toExponent(value));
+}
+
+bool Board::operator==(const Board& other) const
+{
+	return m_size == other.m_size
+		&& m_words[0] == other.m_words[0]
+		&& m_words[1] == other.m_words[1];
+}
+
+bool Board::operator!=(const Board& other) const
+{
+	return !(*this == other);
+}
+
+/**
+	Describe the board by printing its values as a console output
+*/
+void Board::__toString() const
+{
+	for (int y = 0; y < m_size; y++) {
+		for (int x = 0; x < m_size; x++) {
+			std::cout << getValue(x, y) << "\t";
+		}
+
+		std::cout << std::endl;
+	}
+}
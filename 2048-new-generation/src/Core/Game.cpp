@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "Core/Game.h"
+#include "Core/MoveTable.h"
+#include "Core/Bits.h"
+
+/**
+	@param size The number of cells per line
+	@param seed The seed of the game's random generator, the same seed always gives the same spawns
+*/
+Game::Game(int size, uint64_t seed)
+	: m_board(size), m_random(seed)
+{
+	m_score = 0;
+	m_moveCount = 0;
+	m_isMovePossible = true;
+	m_isMovePossibleValid = false;
+
+	// Build the move table now rather than on the first move
+	MoveTable::get(size);
+}
+
+/**
+	Randomly get a value between 2 and 4
+	The AI searches rely on the same TILE_FOUR_PROBABILITY distribution
+
+	@return The random value
+*/
+int Game::getRandomValue()
+{
+	return m_random.nextBool(TILE_FOUR_PROBABILITY) ?
+		4 : 2;
+}
+
+/**
+	Turn two empty cells into valued tiles
+*/
+void Game::start()
+{
+	spawnTile();
+	spawnTile();
+}
+
+/**
+	Slide the board in the provided direction, without ending the turn
+
+	@param dir The direction
+	@return If the board has changed
+*/
+bool Game::move(int dir)
+{
+	int gained = 0;
+
+	if (!m_board.move(dir, &gained)) {
+		return false;
+	}
+
+	m_score += gained;
+	++m_moveCount;
+	invalidateMovePossible();
+
+	return true;
+}
+
+/**
+	Play a whole turn : the move then, if the board has changed, a new tile
+
+	@param dir The direction
+	@return If the board has changed
+*/
+bool Game::play(int dir)
+{
+	if (!move(dir)) {
+		return false;
+	}
+
+	spawnTile();
+
+	return true;
+}
+
+/**
+	Put a random valued tile on a random empty cell
+	The cell is picked directly among the empty ones, without any retry
+
+	@return The index of the cell (y * size + x), -1 if the board is full
+*/
+int Game::spawnTile()
+{
+	uint32_t empty = m_board.getEmptyMask();
+
+	if (empty == 0) {
+		return -1;
+	}
+
+	int size = m_board.getSize();
+	int index = selectBit(empty, m_random.nextInt(popCount(empty)));
+
+	m_board.setValue(index % size, index / size, getRandomValue());
+	invalidateMovePossible();
+
+	return index;
+}
+
+/**
+	Check if the player can still perform an action so the game is not over yet
+	The answer is cached and only computed again once the board has changed
+
+	@return If a move is doable by the player
+*/
+bool Game::isMovePossible()
+{
+	if (!m_isMovePossibleValid) {
+		m_isMovePossible = m_board.hasAnyMove();
+		m_isMovePossibleValid = true;
+	}
+
+	return m_isMovePossible;
+}
+
+/**
+	Called each time the board changes so the game over state is computed again
+*/
+void Game::invalidateMovePossible()
+{
+	m_isMovePossibleValid = false;
+}
+
+const Board& Game::getBoard() const
+{
+	return m_board;
+}
+
+int Game::getScore() const
+{
+	return m_score;
+}
+
+int Game::getMoveCount() const
+{
+	return m_moveCount;
+}
+
+int Game::getMaxTile() const
+{
+	return Board::toValue(m_board.getMaxExponent());
+}
+
+uint64_t Game::getSeed() const
+{
+	return m_random.getSeed();
+}
+
+/**
+	Put the game in a given state, such as a board to replay or to measure from
+
+	@param board The board, of the game's size
+*/
+void Game::setBoard(const Board& board)
+{
+	m_board = board;
+	invalidateMovePossible();
+}
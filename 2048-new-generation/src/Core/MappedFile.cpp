@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "Core/MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	m_data = nullptr;
+	m_size = 0;
+#ifdef _WIN32
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = nullptr;
+#else
+	m_file = -1;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/**
+	Map a file, the previous one is closed first
+
+	@param path The path of the file
+	@return If the file has been mapped, an empty file can not be
+*/
+bool MappedFile::open(const std::string& path)
+{
+	close();
+
+#ifdef _WIN32
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	LARGE_INTEGER size;
+
+	if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	m_size = (size_t)size.QuadPart;
+#else
+	m_file = ::open(path.c_str(), O_RDONLY);
+
+	struct stat status;
+
+	if (m_file < 0 || fstat(m_file, &status) != 0 || status.st_size == 0) {
+		close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, m_file, 0);
+
+	m_data = data != MAP_FAILED ? data : nullptr;
+	m_size = (size_t)status.st_size;
+#endif
+
+	if (!m_data) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+	Unmap the file, the data can not be read anymore
+*/
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+	}
+
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+	}
+
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = nullptr;
+#else
+	if (m_data) {
+		munmap(const_cast<void*>(m_data), m_size);
+	}
+
+	if (m_file >= 0) {
+		::close(m_file);
+	}
+
+	m_file = -1;
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+/**
+	Exchange the mapped files of two instances, so a file can be checked before it replaces the one in use
+
+	@param other The instance to exchange with
+*/
+void MappedFile::swap(MappedFile& other)
+{
+	std::swap(m_data, other.m_data);
+	std::swap(m_size, other.m_size);
+#ifdef _WIN32
+	std::swap(m_mapping, other.m_mapping);
+#endif
+	std::swap(m_file, other.m_file);
+}
+
+/**
+	Tell the system the file is read in no particular order, so it only reads the pages touched
+*/
+void MappedFile::adviseRandomAccess()
+{
+#ifndef _WIN32
+	if (m_data) {
+		madvise(const_cast<void*>(m_data), m_size, MADV_RANDOM);
+	}
+#endif
+}
+
+bool MappedFile::isOpen() const
+{
+	return m_data != nullptr;
+}
+
+/**
+	Get the content of the file, page aligned
+
+	@return The content, null if no file is mapped
+*/
+const void* MappedFile::getData() const
+{
+	return m_data;
+}
+
+/**
+	@return The size of the file, in bytes
+*/
+size_t MappedFile::getSize() const
+{
+	return m_size;
+}
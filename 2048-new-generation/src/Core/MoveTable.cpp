@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "Core/MoveTable.h"
+#include "Core/Board.h"
+
+std::atomic<const MoveTable*> MoveTable::s_tables[GRID_SIZE_MAX + 1];
+
+/**
+	Private constructor, builds the whole table for the provided size
+
+	@param size The number of cells per row
+*/
+MoveTable::MoveTable(int size)
+{
+	m_size = size;
+
+	initializeRows();
+}
+
+/**
+	Build the table of the provided size, the first time it is requested
+	Building is thread-safe thanks to the static local initialization
+
+	@param size The number of cells per row (SIZE_AI_EASY, SIZE_AI_NORMAL or SIZE_AI_HARD)
+	@return The move table
+*/
+const MoveTable& MoveTable::build(int size)
+{
+	const MoveTable* table;
+
+	switch (size) {
+	case SIZE_AI_EASY: {
+		static const MoveTable easy(SIZE_AI_EASY);
+		table = &easy;
+		break;
+	}
+	case SIZE_AI_NORMAL: {
+		static const MoveTable normal(SIZE_AI_NORMAL);
+		table = &normal;
+		break;
+	}
+	default: {
+		static const MoveTable hard(SIZE_AI_HARD);
+		table = &hard;
+		break;
+	}
+	}
+
+	s_tables[size].store(table, std::memory_order_release);
+
+	return *table;
+}
+
+/**
+	Compute the result of sliding each possible row in both directions
+*/
+void MoveTable::initializeRows()
+{
+	uint32_t count = 1U << (4 * m_size);
+
+	m_rows = std::vector<uint64_t>(count);
+
+	for (uint32_t row = 0; row < count; row++) {
+		int left[GRID_SIZE_MAX];
+		int right[GRID_SIZE_MAX];
+
+		// Unpack the row, the right line is read from the last cell
+		for (int i = 0; i < m_size; i++) {
+			left[i] = (row >> (4 * i)) & 0xF;
+			right[m_size - 1 - i] = left[i];
+		}
+
+		uint64_t score = (uint64_t)slideLine(left, m_size, nullptr);
+		uint64_t slidLeft = 0;
+		uint64_t slidRight = 0;
+
+		slideLine(right, m_size, nullptr);
+
+		for (int i = 0; i < m_size; i++) {
+			slidLeft |= (uint64_t)left[i] << (4 * i);
+			slidRight |= (uint64_t)right[m_size - 1 - i] << (4 * i);
+		}
+
+		m_rows[row] = slidLeft | (slidRight << RIGHT_SHIFT) | (score << SCORE_SHIFT);
+	}
+}
+
+/**
+	Slide and merge a line of exponents towards its first cell
+	A tile resulting of a merge can not be merged again during the same move
+	Tiles already at MAX_EXPONENT are never merged since they could not be stored anymore
+	This is the only place the rules are written : the tables and the traces of the moves both come from it
+
+	@param line The exponents of the line, ordered from the cell the tiles slide to
+	@param size The number of cells of the line
+	@param targets Where to store the cell each tile goes to, -1 for the empty cells (can be null)
+	@return The score gained by the merges
+*/
+int MoveTable::slideLine(int* line, int size, int* targets)
+{
+	int result[GRID_SIZE_MAX] = { 0 };
+	int count = 0;
+	int score = 0;
+	bool canMerge = false;
+
+	for (int i = 0; i < size; i++) {
+		int exponent = line[i];
+
+		if (exponent == EMPTY_EXPONENT) {
+			if (targets) {
+				targets[i] = -1;
+			}
+
+			continue;
+		}
+
+		if (canMerge && result[count - 1] == exponent && exponent < MAX_EXPONENT) {
+			result[count - 1] = exponent + 1;
+			score += Board::toValue(exponent + 1);
+			canMerge = false;
+		}
+		else {
+			result[count++] = exponent;
+			canMerge = true;
+		}
+
+		if (targets) {
+			targets[i] = count - 1;
+		}
+	}
+
+	for (int i = 0; i < size; i++) {
+		line[i] = result[i];
+	}
+
+	return score;
+}
+
+/**
+	Get the number of cells per row of the table
+
+	@return The size
+*/
+int MoveTable::getSize() const
+{
+	return m_size;
+}
@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "Core/MoveTrace.h"
+#include "Core/MoveTable.h"
+
+/**
+	Trace every tile of a board, including the ones staying in place
+
+	@param board The board before the move
+	@param dir The direction of the move
+*/
+MoveTrace::MoveTrace(const Board& board, int dir)
+{
+	for (int line = 0; line < board.getSize(); line++) {
+		traceLine(board, dir, line);
+	}
+}
+
+/**
+	Trace the tiles of a single line, read from the cell the tiles slide to
+	The line is slid by MoveTable::slideLine, the very rules the move tables are built with,
+	a tile going to the same cell as the tile before it merges into it
+
+	@param board The board before the move
+	@param dir The direction of the move
+	@param line The row (horizontal moves) or the column (vertical moves)
+*/
+void MoveTrace::traceLine(const Board& board, int dir, int line)
+{
+	int size = board.getSize();
+	bool isVertical = (dir == DIR_UP || dir == DIR_DOWN);
+	bool isReversed = (dir == DIR_RIGHT || dir == DIR_DOWN);
+	int exponents[GRID_SIZE_MAX];
+	int slid[GRID_SIZE_MAX];
+	int targets[GRID_SIZE_MAX];
+
+	for (int i = 0; i < size; i++) {
+		int along = isReversed ? size - 1 - i : i;
+
+		exponents[i] = isVertical ? board.getExponent(line, along) : board.getExponent(along, line);
+		slid[i] = exponents[i];
+	}
+
+	MoveTable::slideLine(slid, size, targets);
+
+	int lastTarget = -1;
+
+	for (int i = 0; i < size; i++) {
+		if (targets[i] < 0) {
+			continue;
+		}
+
+		int along = isReversed ? size - 1 - i : i;
+		int target = isReversed ? size - 1 - targets[i] : targets[i];
+
+		Motion motion;
+		motion.fromX = isVertical ? line : along;
+		motion.fromY = isVertical ? along : line;
+		motion.toX = isVertical ? line : target;
+		motion.toY = isVertical ? target : line;
+		motion.exponent = exponents[i];
+		motion.isMerged = targets[i] == lastTarget;
+		m_motions.push_back(motion);
+
+		lastTarget = targets[i];
+	}
+}
+
+/**
+	Get the motion of every tile of the board
+
+	@return The motions
+*/
+const std::vector<MoveTrace::Motion>& MoveTrace::getMotions() const
+{
+	return m_motions;
+}
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "Core/Options.h"
+
+#include <cstdlib>
+
+/**
+	Parse the command line, any argument not starting with "--" and not following an option is ignored
+
+	@param argc The number of arguments
+	@param argv The arguments, the first one being the program name
+*/
+Options::Options(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg.compare(0, 2, "--") != 0) {
+			continue;
+		}
+
+		arg = arg.substr(2);
+		size_t equal = arg.find('=');
+
+		if (equal != std::string::npos) {
+			m_values[arg.substr(0, equal)] = arg.substr(equal + 1);
+		}
+		else if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+			m_values[arg] = argv[++i];
+		}
+		else {
+			m_values[arg] = "";
+		}
+	}
+}
+
+/**
+	Check if an option has been given
+
+	@param name The option name, without the leading "--"
+	@return If the option is on the command line
+*/
+bool Options::has(const std::string& name) const
+{
+	return m_values.count(name) != 0;
+}
+
+/**
+	Get the value of an option
+
+	@param name The option name, without the leading "--"
+	@param fallback The value to use if the option has not been given
+	@return The value
+*/
+std::string Options::getString(const std::string& name, const std::string& fallback) const
+{
+	std::map<std::string, std::string>::const_iterator it = m_values.find(name);
+
+	return it != m_values.end() ? it->second : fallback;
+}
+
+/**
+	Get the value of an option as an integer
+
+	@param name The option name, without the leading "--"
+	@param fallback The value to use if the option has not been given or is not a number
+	@return The value
+*/
+int Options::getInt(const std::string& name, int fallback) const
+{
+	std::string value = getString(name, "");
+	char* end = nullptr;
+	long number = std::strtol(value.c_str(), &end, 10);
+
+	if (value.empty() || *end != '\0') {
+		return fallback;
+	}
+
+	return (int)number;
+}
+
+/**
+	Get the value of an option as an unsigned 64-bit integer, such as a seed
+
+	@param name The option name, without the leading "--"
+	@param fallback The value to use if the option has not been given or is not a number
+	@return The value
+*/
+uint64_t Options::getUInt64(const std::string& name, uint64_t fallback) const
+{
+	std::string value = getString(name, "");
+	char* end = nullptr;
+	unsigned long long number = std::strtoull(value.c_str(), &end, 10);
+
+	if (value.empty() || value[0] == '-' || *end != '\0') {
+		return fallback;
+	}
+
+	return (uint64_t)number;
+}
+
+/**
+	Get the value of an option as a decimal number
+
+	@param name The option name, without the leading "--"
+	@param fallback The value to use if the option has not been given or is not a number
+	@return The value
+*/
+float Options::getFloat(const std::string& name, float fallback) const
+{
+	std::string value = getString(name, "");
+	char* end = nullptr;
+	float number = std::strtof(value.c_str(), &end);
+
+	if (value.empty() || *end != '\0') {
+		return fallback;
+	}
+
+	return number;
+}
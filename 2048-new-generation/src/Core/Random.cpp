@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "Core/Random.h"
+
+#include <chrono>
+#include <random>
+
+/**
+	@param seed The seed, the same seed always gives the same sequence
+*/
+Random::Random(uint64_t seed)
+{
+	uint64_t state = seed;
+
+	// splitmix64 spreads the seed so close seeds still give unrelated sequences
+	for (int i = 0; i < 4; i++) {
+		m_state[i] = splitMix(state);
+	}
+
+	m_seed = seed;
+}
+
+/**
+	Advance a splitmix64 state and get its next output
+
+	@param state The state to advance
+	@return The next output
+*/
+uint64_t Random::splitMix(uint64_t& state)
+{
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return z ^ (z >> 31);
+}
+
+/**
+	Get a fresh seed for a session that has not been given one
+
+	@return The seed
+*/
+uint64_t Random::createSeed()
+{
+	uint64_t state = std::random_device()();
+	state ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+	return splitMix(state);
+}
+
+/**
+	Get a uniform random integer without the bias of a modulo (Lemire's method)
+
+	@param bound The number of possible values, between 1 and 2^31
+	@return The random integer, between 0 and bound (excluded)
+*/
+int Random::nextInt(int bound)
+{
+	uint32_t range = (uint32_t)bound;
+	uint64_t product = (next() >> 32) * range;
+	uint32_t low = (uint32_t)product;
+
+	if (low < range) {
+		uint32_t threshold = (0U - range) % range;
+
+		while (low < threshold) {
+			product = (next() >> 32) * range;
+			low = (uint32_t)product;
+		}
+	}
+
+	return (int)(product >> 32);
+}
+
+/**
+	Get true with the provided probability
+
+	@param probability The probability, between 0 and 1
+	@return The random boolean
+*/
+bool Random::nextBool(double probability)
+{
+	// The 53 upper bits make a uniform double in [0, 1[
+	return (next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
+/**
+	Get the seed the generator has been built from, to replay its sequence
+
+	@return The seed
+*/
+uint64_t Random::getSeed() const
+{
+	return m_seed;
+}
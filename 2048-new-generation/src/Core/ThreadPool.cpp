@@ -0,0 +1,191 @@
+#include "pch.h"
+#include "Core/ThreadPool.h"
+
+/**
+	@param threadCount The number of threads running the tasks, including the calling one
+	(0 to use every hardware thread, 1 to run everything sequentially)
+*/
+ThreadPool::ThreadPool(int threadCount)
+{
+	if (threadCount <= 0) {
+		threadCount = getHardwareThreadCount();
+	}
+
+	m_queuedCount = 0;
+	m_isStopping = false;
+
+	// The calling thread works too so it needs one worker less
+	for (int i = 0; i < threadCount; i++) {
+		m_queues.push_back(new Queue());
+	}
+
+	for (int i = 1; i < threadCount; i++) {
+		m_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+
+	m_wakeUp.notify_all();
+
+	for (size_t i = 0; i < m_threads.size(); i++) {
+		m_threads[i].join();
+	}
+
+	for (size_t i = 0; i < m_queues.size(); i++) {
+		delete m_queues[i];
+	}
+}
+
+/**
+	Get the number of threads the hardware can run concurrently
+
+	@return The number of threads, at least 1
+*/
+int ThreadPool::getHardwareThreadCount()
+{
+	int count = (int)std::thread::hardware_concurrency();
+
+	return count > 0 ? count : 1;
+}
+
+/**
+	Run body(0) ... body(count - 1) across the pool and wait for all of them
+	The calling thread runs tasks too while it waits, so nested calls from a task can not deadlock
+	With a single thread the indices are run in order, which keeps the results reproducible
+
+	@param count The number of indices
+	@param body The function to run for each index
+*/
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body)
+{
+	if (m_threads.empty()) {
+		for (int i = 0; i < count; i++) {
+			body(i);
+		}
+
+		return;
+	}
+
+	std::atomic<int> remaining(count);
+
+	// Deal the indices between the queues, stealing will even out the load
+	for (int i = 0; i < count; i++) {
+		push(i % (int)m_queues.size(), [&body, &remaining, i]() {
+			body(i);
+			--remaining;
+		});
+	}
+
+	m_wakeUp.notify_all();
+
+	std::function<void()> task;
+
+	while (remaining > 0) {
+		if (pop(0, task)) {
+			task();
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+/**
+	Add a task at the back of a queue
+
+	@param queueIndex The index of the queue
+	@param task The task
+*/
+void ThreadPool::push(int queueIndex, std::function<void()> task)
+{
+	Queue* queue = m_queues[queueIndex];
+
+	{
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		queue->tasks.push_back(std::move(task));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_queuedCount;
+	}
+}
+
+/**
+	Take the last task of a queue, or steal the first task of another one if it is empty
+
+	@param queueIndex The index of the queue owned by the caller
+	@param task Where to store the task
+	@return If a task has been found
+*/
+bool ThreadPool::pop(int queueIndex, std::function<void()>& task)
+{
+	int queueCount = (int)m_queues.size();
+
+	for (int i = 0; i < queueCount; i++) {
+		Queue* queue = m_queues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+
+		if (queue->tasks.empty()) {
+			continue;
+		}
+
+		if (i == 0) {
+			task = std::move(queue->tasks.back());
+			queue->tasks.pop_back();
+		}
+		else {
+			task = std::move(queue->tasks.front());
+			queue->tasks.pop_front();
+		}
+
+		--m_queuedCount;
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+	Run tasks until the pool is destroyed, sleeping while every queue is empty
+
+	@param queueIndex The index of the queue owned by the worker
+*/
+void ThreadPool::workerLoop(int queueIndex)
+{
+	std::function<void()> task;
+
+	while (true) {
+		if (pop(queueIndex, task)) {
+			task();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		m_wakeUp.wait(lock, [this]() {
+			return m_isStopping || m_queuedCount > 0;
+		});
+
+		if (m_isStopping) {
+			return;
+		}
+	}
+}
+
+/**
+	Get the number of threads running the tasks, including the calling one
+
+	@return The number of threads
+*/
+int ThreadPool::getThreadCount()
+{
+	return (int)m_queues.size();
+}
@@ -1,8 +1,16 @@
 #include "pch.h"
 #include "Engine/Engine.h"
+#include "Constants.h"
 
 void Engine::draw()
 {
+	// The event loop keeps showing the last frame as long as nothing has changed
+	if (m_loopPolicy == LOOP_EVENT && !m_needsRedraw) {
+		return;
+	}
+
+	m_needsRedraw = false;
+
 	// Rub out the last frame
 	m_window.clear(Color::Black);
 	
@@ -2,7 +2,15 @@
 #include "Engine/Engine.h"
 #include "Constants.h"
 
-Engine::Engine()
+/**
+	@param seed The seed of the game, the same seed and the same moves always give the same game
+	@param loopPolicy LOOP_FIXED, LOOP_VSYNC or LOOP_EVENT
+	@param framerate The highest framerate for LOOP_FIXED and LOOP_EVENT
+	@param animationDuration The time a move takes on screen in milliseconds, 0 to show moves instantly
+	@param heuristicPath The config file of the weights of the AI's heuristic, the default weights are kept if it can not be read
+*/
+Engine::Engine(uint64_t seed, int loopPolicy, unsigned int framerate, int animationDuration, const std::string& heuristicPath)
+	: m_random(Random::createSeed())
 {
 	// Get the screen resolution and create an SFML window and the view
 	Vector2f resolution;
@@ -15,9 +23,6 @@ Engine::Engine()
 	sf::ContextSettings settings;
 	settings.antialiasingLevel = 8;
 
-	// Disable key repeating
-	m_window.setKeyRepeatEnabled(false);
-
 	m_window.create(
 		VideoMode(resolution.x, resolution.y),
 		"2048 with SFML",
@@ -25,10 +30,55 @@ Engine::Engine()
 		settings
 	);
 
+	// Disable key repeating, a held key only queues a single move
+	// (only effective once the window exists)
+	m_window.setKeyRepeatEnabled(false);
+
+	m_loopPolicy = loopPolicy;
+	setupLoop(framerate);
+
 	// Instantiate game entities
-	m_grid = Grid::createGrid(AI_HARD);
-	// A vector that helps us to know if the user can move in any direction during the current turn
-	dirDataBuffer = std::vector<int>(4);
+	m_grid = Grid::createGrid(AI_HARD, seed);
+	m_grid->setAnimationDuration(milliseconds(animationDuration));
+	m_grid->loadHeuristic(heuristicPath);
+
+	// Moves typed ahead of the board, the extra ones are dropped
+	dirDataBuffer = std::vector<MoveCommand>(INPUT_BUFFER_SIZE);
+}
+
+/**
+	Convert a loop policy name from the command line into its value
+
+	@param name "fixed", "vsync" or "event"
+	@return The loop policy, LOOP_FIXED if the name is unknown
+*/
+int Engine::parseLoopPolicy(const std::string& name)
+{
+	if (name == "vsync") {
+		return LOOP_VSYNC;
+	}
+
+	if (name == "event") {
+		return LOOP_EVENT;
+	}
+
+	return LOOP_FIXED;
+}
+
+/**
+	Pace the main loop according to its policy
+
+	@param framerate The highest framerate for LOOP_FIXED and LOOP_EVENT
+*/
+void Engine::setupLoop(unsigned int framerate)
+{
+	if (m_loopPolicy == LOOP_VSYNC) {
+		m_window.setVerticalSyncEnabled(true);
+	}
+	else {
+		// The event loop is still capped while the AI plays on its own
+		m_window.setFramerateLimit(framerate);
+	}
 }
 
 /**
@@ -37,6 +87,9 @@ Engine::Engine()
 void Engine::start()
 {
 	while (m_window.isOpen()) {
+		// Sleep until something happens, unless the AI, queued moves or an animation have to be played
+		processEvents(m_loopPolicy == LOOP_EVENT && !isAutoPlay && dirDataCount == 0 && !m_grid->isAnimating());
+
 		input();
 		update();
 		draw();
@@ -48,4 +101,5 @@ void Engine::start()
 	}
 
 	// Window has been closed
+	reportLatency();
 }
\ No newline at end of file
@@ -4,70 +4,163 @@
 #include <chrono>
 #include <ctime>    
 
-bool Engine::isActionKeyPressed()
-{
-	return isMoveKeyPressed()
-		|| Keyboard::isKeyPressed(Keyboard::Escape)
-		|| Keyboard::isKeyPressed(Keyboard::S);
-}
+/**
+	Empty the window's event queue
 
-bool Engine::isMoveKeyPressed()
+	@param isBlocking If the call has to wait for at least one event
+*/
+void Engine::processEvents(bool isBlocking)
 {
-	return Keyboard::isKeyPressed(Keyboard::Left)
-		|| Keyboard::isKeyPressed(Keyboard::Right)
-		|| Keyboard::isKeyPressed(Keyboard::Up)
-		|| Keyboard::isKeyPressed(Keyboard::Down);
+	Event event;
+
+	if (isBlocking && m_window.waitEvent(event)) {
+		handleEvent(event);
+	}
+
+	while (m_window.pollEvent(event)) {
+		handleEvent(event);
+	}
 }
 
-void Engine::input()
+/**
+	React to a window event
+	Key presses are handled as they come so even the shortest ones are never missed
+
+	@param event The event
+*/
+void Engine::handleEvent(const Event& event)
 {
-	if (isActionKeyPressed()) {
-		if (Keyboard::isKeyPressed(Keyboard::Escape)) {
+	switch (event.type) {
+	case Event::Closed:
+		m_window.close();
+		break;
+	case Event::Resized:
+	case Event::GainedFocus:
+		// The window content may have been lost
+		m_needsRedraw = true;
+		break;
+	case Event::KeyPressed:
+		switch (event.key.code) {
+		case Keyboard::Escape:
 			m_window.close();
 			// Handle start menu here
-
-			// Block multiple events
-			wasActionKeyPressed = true;
+			break;
+		case Keyboard::S:
+			screenshot();
+			break;
+		case Keyboard::A:
+			// Let the AI play or give the control back to the player
+			isAutoPlay = !isAutoPlay;
+			break;
+		case Keyboard::Left:
+			pushMove(DIR_LEFT);
+			break;
+		case Keyboard::Right:
+			pushMove(DIR_RIGHT);
+			break;
+		case Keyboard::Up:
+			pushMove(DIR_UP);
+			break;
+		case Keyboard::Down:
+			pushMove(DIR_DOWN);
+			break;
+		default:
+			break;
 		}
+		break;
+	default:
+		break;
+	}
+}
 
-		if (isMoveKeyPressed() && !wasActionKeyPressed) {
-			if (Keyboard::isKeyPressed(Keyboard::Left)) {
-				m_grid->moveLeft();
-			}
+/**
+	Queue a move typed by the player, it is dropped if too many moves are already waiting
 
-			if (Keyboard::isKeyPressed(Keyboard::Right)) {
-				m_grid->moveRight();
-			}
+	@param dir The direction
+*/
+void Engine::pushMove(int dir)
+{
+	if (dirDataCount == (int)dirDataBuffer.size()) {
+		return;
+	}
 
-			if (Keyboard::isKeyPressed(Keyboard::Up)) {
-				m_grid->moveUp();
-			}
+	MoveCommand& command = dirDataBuffer[(dirDataHead + dirDataCount) % dirDataBuffer.size()];
+	command.dir = dir;
+	command.time = m_clock.getElapsedTime();
+	++dirDataCount;
+}
 
-			if (Keyboard::isKeyPressed(Keyboard::Down)) {
-				m_grid->moveDown();
-			}
+/**
+	Play the oldest queued move, at most one move is played per turn
+*/
+void Engine::input()
+{
+	if (dirDataCount == 0) {
+		return;
+	}
 
-			// Move the grid's tiles
-			m_grid->moveTiles();
+	MoveCommand command = dirDataBuffer[dirDataHead];
+	dirDataHead = (dirDataHead + 1) % dirDataBuffer.size();
+	--dirDataCount;
 
-			// Turn is over so we generate a new tile randomly on the grid
-			m_grid->newTile();
+	// The AI has the control, moves typed meanwhile are dropped
+	if (isAutoPlay) {
+		return;
+	}
 
-			// Turn on test context
-			m_grid->turnOnTest();
+	playMove(command);
+}
 
-			// Block multiple events
-			wasActionKeyPressed = true;
-		}
+/**
+	Play a queued move on the grid and measure how long it has waited
 
-		// Screenshot
-		if (Keyboard::isKeyPressed(Keyboard::S) && !wasActionKeyPressed) {
-			screenshot();
-		}
+	@param command The move
+*/
+void Engine::playMove(const MoveCommand& command)
+{
+	switch (command.dir) {
+	case DIR_LEFT:
+		m_grid->moveLeft();
+		break;
+	case DIR_RIGHT:
+		m_grid->moveRight();
+		break;
+	case DIR_UP:
+		m_grid->moveUp();
+		break;
+	default:
+		m_grid->moveDown();
 	}
-	else {
-		wasActionKeyPressed = false;
+
+	// Move the grid's tiles
+	// If nothing has moved the turn is not over
+	if (m_grid->moveTiles()) {
+		// Turn is over so we generate a new tile randomly on the grid
+		m_grid->newTile();
 	}
+
+	Time latency = m_clock.getElapsedTime() - command.time;
+
+	++m_latencyCount;
+	m_latencyTotal += latency;
+
+	if (latency > m_latencyMax) {
+		m_latencyMax = latency;
+	}
+}
+
+/**
+	Print the input latency measured during the session
+*/
+void Engine::reportLatency()
+{
+	if (m_latencyCount == 0) {
+		return;
+	}
+
+	std::cout << "Input latency : mean " << m_latencyTotal.asMicroseconds() / m_latencyCount
+		<< " us, max " << m_latencyMax.asMicroseconds()
+		<< " us over " << m_latencyCount << " moves" << std::endl;
 }
 
 void Engine::screenshot()
@@ -79,14 +172,11 @@ void Engine::screenshot()
 	sf::Image screenshot = texture.copyToImage();
 	std::string filename = getFilename("screenshots", "png");
 	screenshot.saveToFile(filename);
-
-	// Block multiple events
-	wasActionKeyPressed = true;
 }
 
 long Engine::uniqueID()
 {
-	return rand() % LONG_MAX;
+	return (long)(m_random.next() % LONG_MAX);
 }
 
 std::string Engine::getFilename(const char* module, const char* extension)
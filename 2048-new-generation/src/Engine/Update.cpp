@@ -5,5 +5,15 @@ using namespace sf;
 
 void Engine::update()
 {
-	m_grid->update();
+	// The AI plays one turn per frame
+	if (isAutoPlay) {
+		m_grid->playAI();
+	}
+
+	// Time spent since the last update, including any sleep in the event loop
+	Time dt = m_frameClock.restart();
+
+	if (m_grid->update(dt)) {
+		m_needsRedraw = true;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "Constants.h"
+#include "Entities/Animation.h"
+
+Animation::Animation()
+{
+	m_duration = milliseconds(ANIMATION_DURATION);
+	m_elapsed = Time::Zero;
+	m_isRunning = false;
+	m_isFirstFrame = false;
+}
+
+/**
+	Start showing a move, the previous one is dropped if it was still shown
+
+	@param trace The motions of the tiles during the move
+*/
+void Animation::start(const MoveTrace& trace)
+{
+	if (m_duration <= Time::Zero) {
+		return;
+	}
+
+	m_motions = trace.getMotions();
+	m_elapsed = Time::Zero;
+	m_isRunning = true;
+	m_isFirstFrame = true;
+}
+
+/**
+	Move the animation forward
+
+	@param dt The time elapsed since the last update
+	@return If the animation has advanced, so the frame has to be drawn again
+*/
+bool Animation::update(Time dt)
+{
+	if (!m_isRunning) {
+		return false;
+	}
+
+	// The first frame shows the tiles where they were
+	if (m_isFirstFrame) {
+		m_isFirstFrame = false;
+		return true;
+	}
+
+	m_elapsed += dt;
+
+	if (m_elapsed >= m_duration) {
+		stop();
+	}
+
+	return true;
+}
+
+/**
+	Jump to the end of the animation
+*/
+void Animation::stop()
+{
+	m_isRunning = false;
+	m_motions.clear();
+}
+
+bool Animation::isRunning()
+{
+	return m_isRunning;
+}
+
+/**
+	Get how far the tiles are on their way, slowing down as they arrive
+
+	@return The progress, from 0 to 1
+*/
+float Animation::getProgress()
+{
+	float t = m_elapsed.asSeconds() / m_duration.asSeconds();
+
+	if (t > 1.0f) {
+		t = 1.0f;
+	}
+
+	return 1.0f - (1.0f - t) * (1.0f - t);
+}
+
+const std::vector<MoveTrace::Motion>& Animation::getMotions()
+{
+	return m_motions;
+}
+
+/**
+	@param duration The time a move takes on screen, zero to show moves instantly
+*/
+void Animation::setDuration(Time duration)
+{
+	m_duration = duration;
+}
@@ -2,24 +2,24 @@
 
 #include "Constants.h"
 #include "Entities/Grid.h"
-#include "AI/AI_Easy.h"
-#include "AI/AI_Normal.h"
-#include "AI/AI_Hard.h"
+#include "Entities/Quad.h"
 
+#include <cmath>
 #include <iostream>
 
-Grid *Grid::self = false;
+Grid *Grid::self = nullptr;
 
 /**
 	Static function called to instantiate a new grid with a specific AI
 	Create a new grid only if none has been created
 
 	@param The AI chosen for the game
+	@param seed The seed of the game
 	@return The current grid instance
 */
-Grid* Grid::createGrid(int AI) {
+Grid* Grid::createGrid(int AI, uint64_t seed) {
 	if (!self) {
-		self = new Grid(AI);
+		self = new Grid(AI, seed);
 	}
 
 	return self;
@@ -28,16 +28,17 @@ Grid* Grid::createGrid(int AI) {
 /**
 	Private constructor
 */
-Grid::Grid(int AI)
+Grid::Grid(int AI, uint64_t seed)
 {	
-	initializeDirections();
-
-	doMerge = false;
+	m_dir = DIR_NONE;
+	m_quads = VertexArray(Quads);
+	m_faces = VertexArray(Quads);
 	setupSizePix();
 	setupShape();
 	setupAI(AI);
-	setupSize();
+	setupSize(seed);
 	setupFont();
+	setupAtlas();
 	centerShape();
 	initializeTiles();
 
@@ -50,24 +51,43 @@ Grid::Grid(int AI)
 */
 void Grid::setupAI(int AI)
 {
-	switch (AI) {
-	case AI_EASY:
-		m_AI = new AI_Easy();
-		break;
-	case AI_NORMAL:
-		m_AI = new AI_Normal();
-		break;
-	default:
-		m_AI = new AI_Hard();
+	m_AI = AI::create(AI, AI::getLevelThreadCount(AI), AI::getLevelTimeBudget(AI));
+}
+
+/**
+	Evaluate the boards of the AI with the heuristic weighted by a config file
+
+	@param path The config file of the weights of the heuristic
+	@return If the weights have been loaded, the AI keeps its evaluator otherwise
+*/
+bool Grid::loadHeuristic(const std::string& path)
+{
+	HeuristicEvaluator::Weights weights;
+	std::string error;
+
+	if (!HeuristicEvaluator::loadWeights(path, &weights, &error)) {
+		std::cout << "Cannot load " << path << " : " << error << std::endl;
+		return false;
 	}
+
+	HeuristicEvaluator* heuristic = new HeuristicEvaluator(m_size, weights);
+
+	m_AI->setEvaluator(heuristic);
+	delete m_heuristic;
+	m_heuristic = heuristic;
+
+	return true;
 }
 
 /**
-	Setup the size of the grid according to its AI
+	Setup the size of the grid according to its AI and start its game
+
+	@param seed The seed of the game
 */
-void Grid::setupSize()
+void Grid::setupSize(uint64_t seed)
 {
 	m_size = m_AI->getGridSize();
+	m_game = new Game(m_size, seed);
 }
 
 /**
@@ -109,31 +129,17 @@ void Grid::centerShape()
 	);
 }
 
-/**
-	Initialize the vector storing the directions
-*/
-void Grid::initializeDirections()
-{
-	directions.push_back(DIR_LEFT);
-	directions.push_back(DIR_RIGHT);
-	directions.push_back(DIR_UP);
-	directions.push_back(DIR_DOWN);
-}
-
 /**
 	Initialize properly the grid according to its size
+	Tiles are created once as ghosts in a single contiguous pool and only mirror the board afterwards
 */
 void Grid::initializeTiles()
 {
-	using namespace std;
-
-	for (int i = 0; i < m_size; i++) {
-		m_tiles.push_back(vector<Tile*>()); // Add an empty row
-	}
+	m_tiles.reserve(m_size * m_size);
 
-	for (int x = 0; x < m_size; x++) {
-		for (int y = 0; y < m_size; y++) {
-			m_tiles[x].push_back(Tile::createGhost(x, y, this));
+	for (int y = 0; y < m_size; y++) {
+		for (int x = 0; x < m_size; x++) {
+			m_tiles.push_back(Tile(x, y, this));
 		}
 	}
 
@@ -142,32 +148,34 @@ void Grid::initializeTiles()
 }
 
 /**
-	Turn two ghost tiles into valued tiles
+	Turn two empty cells into valued tiles
 */
 void Grid::setupTilesStates()
 {
-	int a = getRandomIndex();
-	int b = getRandomIndex();
-	
-	while (count() < 2) {
-		if (m_tiles[a][b]->isGhost()) {
-			delete(m_tiles[a][b]);
-			m_tiles[a][b] = Tile::createRandom(a, b, this);
-		}
+	m_game->start();
 
-		a = getRandomIndex();
-		b = getRandomIndex();
+	// Both starting tiles are shown as new
+	for (int x = 0; x < m_size; x++) {
+		for (int y = 0; y < m_size; y++) {
+			if (!m_game->getBoard().isEmpty(x, y)) {
+				m_newTiles |= 1U << (y * m_size + x);
+			}
+		}
 	}
 }
 
 /**
-	Refresh every grid's tile's state
+	Refresh every grid's tile's state from the board
+	Only the tiles whose state has actually changed will be updated
 */
 void Grid::refreshTiles()
 {
-	for (int x = 0; x < m_size; x++) {
-		for (int y = 0; y < m_size; y++) {
-			m_tiles[x][y]->refresh();
+	for (int y = 0; y < m_size; y++) {
+		for (int x = 0; x < m_size; x++) {
+			Tile* tile = getTile(x, y);
+
+			tile->setValue(m_game->getBoard().getValue(x, y));
+			tile->setNewlyCreated(isNewTile(x, y));
 		}
 	}
 }
@@ -177,42 +185,14 @@ void Grid::refreshTiles()
  */
 void Grid::newTile()
 {
-	if (!isRoomAvailable()) {
-		return;
-	}
-
-	int a = getRandomIndex();
-	int b = getRandomIndex();
-	int currentCount = count();
+	int index = m_game->spawnTile();
 
-	while (currentCount == count()) {
-		if (m_tiles[a][b]->isGhost()) {
-			m_tiles[a][b] = Tile::createRandom(a, b, this);
-		}
-
-		a = getRandomIndex();
-		b = getRandomIndex();
+	if (index == -1) {
+		return;
 	}
-}
-
-/**
-	Check if any room is still available on the grid
-
-	@return If there is room available on the grid
-*/
-bool Grid::isRoomAvailable()
-{
-	return count() != (m_size * m_size);
-}
-
-/**
-	Randomly get an index between 0 and the size of the grid (excluded) 
 
-	@return The random index
-*/
-int Grid::getRandomIndex()
-{
-	return rand() % m_size;
+	m_newTiles |= 1U << index;
+	refreshTiles();
 }
 
 /**
@@ -231,128 +211,44 @@ void Grid::setupFont()
 	if (!m_font) {
 		m_font = new Font();
 
-		if (!m_font->loadFromFile("assets\\fonts\\Superfats.ttf")) {
+		if (!m_font->loadFromFile("assets/fonts/Superfats.ttf")) {
 			// debug
 			//std::cout << "......... cannot load font ---->" << std::endl;
 		}
-	}
-}
-
-/**
-	Computes the proper tile size according to the screen's size and the grid's size
 
-	@return The tile size
-*/
-float Grid::getTileSize()
-{
-	return (m_size_pix / (float) m_size);
+		// Rasterize every digit up front so the glyph atlas never changes during the game
+		for (char digit = '0'; digit <= '9'; digit++) {
+			m_font->getGlyph(digit, TEXT_ATLAS_SIZE, false);
+		}
+	}
 }
 
 /**
-	[NOTE : Maybe should be handled by the AI]
-	Randomly get a value between 2 and 4
-
-	@return The random value
+	Setup the cache of tile faces, rendered for the exact tile size of the grid
 */
-int Grid::getRandomValue()
+void Grid::setupAtlas()
 {
-	return round((double) rand() / RAND_MAX) == 0 ?
-		2 : 4;
+	m_atlas = new TileAtlas(m_font, (unsigned int)std::ceil(getTileSize()));
 }
 
 /**
-	Check if the provided tile can move according in the input direction
+	Get the cache of tile faces
 
-	@param The tile we try to move
-	@return If the tile can move
+	@return The atlas
 */
-bool Grid::canMove(Tile* currentTile)
+TileAtlas* Grid::getAtlas()
 {
-	if (currentTile->isGhost()) {
-		return false;
-	}
-
-	doMerge = false;
-
-	// The tile can not be moved if there's an edge in the trajectory
-	// Or if there is a tile it can not be merged with
-	Vector2f pos = currentTile->getIndex();
-
-	// Step 1 : check if there is an edge
-	if (isThereAnEdge(&pos)) {
-		return false;
-	}
-
-	// Step 2 : check if there is a neighbour tile
-	// If yes, retrieve the tile
-	Tile *neighbourTile = getTile((int)pos.x, (int)pos.y);
-	if (!isThereANeighbour(neighbourTile)) { // If no neighbour tile, then there is a free space to move to
-		return true;
-	}
-
-	// Check if the neighbour tile and the current one can be merged
-	if (doMerge = currentTile->isMergeable(neighbourTile) && !_isTest) {
-		currentTile->setIndex(neighbourTile->getIndex());
-	}
-
-	return false;
+	return m_atlas;
 }
 
 /**
-	Check if there is an edge in the input direction
-	If not, the function save the targeted tile's coordinates in the provided pos param
+	Computes the proper tile size according to the screen's size and the grid's size
 
-	@param pos Coordinates of the tile we try to move 
-	@return If there is an edge in the input direction
+	@return The tile size
 */
-bool Grid::isThereAnEdge(Vector2f* pos)
+float Grid::getTileSize()
 {
-	switch (m_dir) {
-		case DIR_LEFT:			
-			if ((int)pos->x == 0) {
-				return true;
-			}
-
-			pos->x -= 1.0f;
-			break;
-		case DIR_RIGHT:
-			if ((int)pos->x == (m_size - 1)) {
-				return true;
-			}
-			pos->x += 1.0f;
-			break;
-		case DIR_UP:
-			if ((int)pos->y == 0) {
-				return true;
-			}
-
-			pos->y -= 1.0f;
-			break;
-		default: // DIR_DOWN			
-			if ((int)pos->y == (m_size - 1)) {
-				return true;
-			}
-
-			pos->y += 1.0f;
-	}
-
-	return false;
-}
-
-/**
-	Check if there is a neighbour tile in the input direction
-
-	@param targetPos Coordinates of the target tile
-	@param targetPos Reference to the neighbour tile
-	@return If there is a neighbour tile in the input direction
-*/
-bool Grid::isThereANeighbour(Tile* neighbourTile)
-{	
-	if (neighbourTile->isGhost()) {
-		return false;
-	}
-
-	return true;
+	return (m_size_pix / (float) m_size);
 }
 
 /**
@@ -388,132 +284,48 @@ void Grid::moveDown()
 }
 
 /**
-	Move each tile of the grid in the input direction
-	And organize the order we move the tiles in 
-	It will not necessarily be the same according to the direction
-	That mainly allows us to avoid tiles blocking
+	Slide the board in the input direction
+	The tiles are then synced with the new state of the board
+
+	@return If the board has changed
 */
-void Grid::moveTiles()
+bool Grid::moveTiles()
 {
-	if (m_dir == DIR_LEFT) {
-		for (int x = 0; x < m_size; x++) {
-			for (int y = 0; y < m_size; y++) {
-				move(x, y);
-
-				// [TEST CONTEXT]
-				// If we have found that a move is possible
-				// Break the searching process here
-				if (_isTest && _isMovePossible) {
-					return;
-				}
-			}
-		}
-	}
-
-	else if (m_dir == DIR_RIGHT) {
-		for (int x = (m_size - 1); x > -1; x--) {
-			for (int y = 0; y < m_size; y++) {
-				move(x, y);
-
-				if (_isTest && _isMovePossible) {
-					return;
-				}
-			}
-		}
-	}
-
-	else if (m_dir == DIR_UP) {
-		for (int x = 0; x < m_size; x++) {
-			for (int y = 0; y < m_size; y++) {
-				move(x, y);
-
-				if (_isTest && _isMovePossible) {
-					return;
-				}
-			}
-		}
+	if (m_dir == DIR_NONE) {
+		return false;
 	}
 
-	else { // (m_dir = DIR_DOWN) 
-		for (int x = 0; x < m_size; x++) {
-			for (int y = (m_size - 1); y > -1; y--) {
-				move(x, y);
-
-				if (_isTest && _isMovePossible) {
-					return;
-				}
-			}
-		}
-	}
+	Board before = m_game->getBoard();
+	bool hasMoved = m_game->move(m_dir);
 
-	// [TEST CONTEXT]
-	// If here that means no move action will be doable by the player next turn
-	// We can stop the process here
-	if (_isTest) {
-		return;
+	// The board is already up to date, the animation only shows how it got there
+	if (hasMoved) {
+		m_animation.start(MoveTrace(before, m_dir));
 	}
 
 	m_dir = DIR_NONE;
 	unnewTiles();
 	refreshTiles();
+
+	return hasMoved;
 }
 
 /**
-	Move the tile at the provided coordinates in the input direction
+	Let the grid's AI play a whole turn : its move then the new tile
 
-	@param x column coordinate
-	@param y line coordinate
+	@return If the AI has been able to move
 */
-void Grid::move(int x, int y)
+bool Grid::playAI()
 {
-	Tile *tile = m_tiles[x][y];
-	
-	// Those variable are used to store the current tile coordinates as long as the tile CAN MOVE
-	// Because canMove() function actually overrides the current tile coordinates in case it can be merged with a neighbour and returns false
-	// We can notice a coordinates offset so we make sure to use the right synced ones
-	int a = x, b = y;
-
-	// This loop aims to move the tile as long as there is no obstacle in its trajectory
-	while (canMove(tile)) {
-		// [TEST CONTEXT]
-		// We have found that at least one move will be doable by the player next turn
-		// We can then save the information and stop the searching process
-		if (_isTest) {
-			_isMovePossible = true;
-
-			return;
-		}
-
-		switch (m_dir) {
-		case DIR_LEFT:
-			tile->moveLeft();
-			break;
-		case DIR_RIGHT:
-			tile->moveRight();
-			break;
-		case DIR_UP:
-			tile->moveUp();
-			break;
-		default:
-			tile->moveDown();
-		}
+	m_dir = m_AI->chooseMove(m_game->getBoard());
 
-		a = tile->getX();
-		b = tile->getY();
+	if (!moveTiles()) {
+		return false;
 	}
 
-	// [TEST CONTEXT]
-	// If a merge is pending that means the player will be able to perform an action
-	// We can then stop the process here
-	if (doMerge && _isTest) {
-		_isMovePossible = true;
-
-		return;
-	}
+	newTile();
 
-	mergeTiles(a, b, tile);
-	doMerge = false;
-	refreshTiles();
+	return true;
 }
 
 /**
@@ -522,34 +334,19 @@ void Grid::move(int x, int y)
 */
 void Grid::unnewTiles()
 {
-	for (int i = 0; i < m_size; i++) {
-		for (int j = 0; j < m_size; j++) {
-			m_tiles[i][j]->setNewlyCreated(false);
-			m_tiles[i][j]->setNew(false);
-		}
-	}
+	m_newTiles = 0;
 }
 
 /**
-	Merge the tile at the provided position with the target one
+	Check if the tile at the provided coordinates has been spawned at the end of the last turn
 
-	@param current_x x coordinate of the current tile
-	@param current_y y coordinate of the current tile
-	@param t The targeted tile we do the merge with
+	@param x The x coordinate
+	@param y The y coordinate
+	@return If the tile is new
 */
-void Grid::mergeTiles(int current_x, int current_y, Tile* t)
+bool Grid::isNewTile(int x, int y)
 {
-	// This doMerge variable is set to true in canMove() function
-	if (doMerge) {		
-		// The tile to merge
-		removeTile(current_x, current_y);
-		getTile(current_x, current_y)->refresh();
-
-		// The tile hosting the merge
-		t->up();
-		setTile(t->getX(), t->getY(), t);
-		getTile(t->getX(), t->getY())->refresh();
-	}
+	return (m_newTiles >> (y * m_size + x)) & 1U;
 }
 
 /**
@@ -571,38 +368,35 @@ int Grid::getSize()
 }
 
 /**
-	Update the grid by setting a tile to provided coordinates
+	Get the tile at the provided coordinates
 
-	@param x The x position to set the tile at
-	@param y The y position to set the tile at
-	@param tile The tile to set
+	@param x The x coordinate
+	@param y The x coordinate
+	@return The tile at the provided coordinates
 */
-void Grid::setTile(int x, int y, Tile* tile)
+Tile* Grid::getTile(int x, int y)
 {
-	m_tiles[x][y] = tile;
+	return &m_tiles[y * m_size + x];
 }
 
 /**
-	Get the tile at the provided coordinates
+	Get the score made since the beginning of the game
 
-	@param x The x coordinate
-	@param y The x coordinate
-	@return The tile at the provided coordinates
+	@return The score
 */
-Tile* Grid::getTile(int x, int y)
+int Grid::getScore()
 {
-	return m_tiles[x][y];
+	return m_game->getScore();
 }
 
 /**
-	Create a ghost at the provided coordinates
+	Get the board storing the game state
 
-	@param x The x coordinate to create a ghost at
-	@param y The x coordinate to create a ghost at
+	@return The board
 */
-void Grid::removeTile(int x, int y)
+const Board& Grid::getBoard()
 {
-	m_tiles[x][y] = Tile::createGhost(x, y, this);
+	return m_game->getBoard();
 }
 
 /**
@@ -612,98 +406,129 @@ void Grid::removeTile(int x, int y)
 */
 int Grid::count()
 {
-	int count = 0;
-
-	for (int i = 0; i < m_size; i++) {
-		for (int j = 0; j < m_size; j++) {
-			if (!(m_tiles[i][j]->isGhost())) {
-				++count;
-			}
-		}
-	}
-
-	return count;
+	return m_game->getBoard().countTiles();
 }
 
-/*
-	Test for each direction if a move can be done for at least one tile
-	If yes that means the player can still perform an action for the next turn so the game is not over yet
+/**
+	Check if the player can still perform an action so the game is not over yet
 
 	@return If a move is doable by the player
 */
 bool Grid::isMovePossible()
 {
-	if (!_isTest) {
-		return true;
-	}
+	return m_game->isMovePossible();
+}
 
-	// Iterates on each known direction
-	for (std::vector<int>::iterator ite = directions.begin(); ite != directions.end(); ++ite) {
-		// Save the value of the direction as the current direction
-		m_dir = *ite;
-		moveTiles();
-		
-		if (_isMovePossible) {
-			resetTestVariables();
+/**
+	Update each tile of the grid and the running animation,
+	the vertex arrays are built again on the next draw only if something has changed
+
+	@param dt The time elapsed since the last update
+	@return If the grid has to be drawn again
+*/
+bool Grid::update(Time dt)
+{
+	if (m_animation.update(dt)) {
+		m_isBatchDirty = true;
+	}
 
-			return true;
+	// Update each changed tile of the grid
+	for (size_t i = 0; i < m_tiles.size(); i++) {
+		if (m_tiles[i].update()) {
+			m_isBatchDirty = true;
 		}
 	}
 
-	resetTestVariables();
+	return m_isBatchDirty;
+}
+
+/**
+	Gather the grid and all of its tiles into the two vertex arrays
+*/
+void Grid::buildVertices()
+{
+	m_quads.clear();
+	m_faces.clear();
+
+	appendQuad(m_quads, m_shape.getGlobalBounds(), m_shape.getFillColor());
+
+	if (m_animation.isRunning()) {
+		buildAnimationVertices();
+		return;
+	}
 
-	return false;
+	for (size_t i = 0; i < m_tiles.size(); i++) {
+		m_tiles[i].batch(m_faces);
+	}
 }
 
 /**
-	Used by the engine to turn on TEST context before starting a new turn
+	Gather the tiles as they are during the animation : empty cells
+	with the tiles of the previous board sliding on top of them
 */
-void Grid::turnOnTest()
+void Grid::buildAnimationVertices()
 {
-	_isTest = true;
+	float tileSize = getTileSize();
+	float progress = m_animation.getProgress();
+	FloatRect ghost = m_atlas->getFace(GHOST_VAL, false);
+	const std::vector<MoveTrace::Motion>& motions = m_animation.getMotions();
+
+	for (size_t i = 0; i < m_tiles.size(); i++) {
+		Vector2f position = m_tiles[i].getPosition();
+
+		appendQuad(m_faces, FloatRect(position.x, position.y, tileSize, tileSize), Color::White, ghost);
+	}
+
+	for (size_t i = 0; i < motions.size(); i++) {
+		const MoveTrace::Motion& motion = motions[i];
+		Vector2f from = getTile(motion.fromX, motion.fromY)->getPosition();
+		Vector2f to = getTile(motion.toX, motion.toY)->getPosition();
+		FloatRect face = m_atlas->getFace(Board::toValue(motion.exponent), false);
+		FloatRect rect(
+			from.x + (to.x - from.x) * progress,
+			from.y + (to.y - from.y) * progress,
+			tileSize,
+			tileSize
+		);
+
+		appendQuad(m_faces, rect, Color::White, face);
+	}
 }
 
 /**
-	Reset TEST context variables after finishing the test/searching process
+	Check if a move is still being shown
+
+	@return If the animation is running
 */
-void Grid::resetTestVariables()
+bool Grid::isAnimating()
 {
-	// Reset variables default values
-	m_dir = DIR_NONE;
-	doMerge = false;
-	_isTest = false;
-	_isMovePossible = false;
+	return m_animation.isRunning();
 }
 
 /**
-	Update each tile of the grid
+	Set how long a move takes on screen
+
+	@param duration The duration, zero to show moves instantly
 */
-void Grid::update()
+void Grid::setAnimationDuration(Time duration)
 {
-	// Update each tile of the grid
-	for (int x = 0; x < m_size; x++) {
-		for (int y = 0; y < m_size; y++) {
-			m_tiles[x][y]->update();
-		}
-	}
+	m_animation.setDuration(duration);
 }
 
 /**
-	Draw each tile of the grid
+	Draw the whole grid in two draw calls : its background, then the faces of the tiles
 
 	@param w The window instance
 */
 void Grid::draw(RenderWindow* w)
 {
-	// Draw the grid
-	w->draw(m_shape);
-
-	// Draw each tile of the grid
-	for (int x = 0; x < m_size; x++) {
-		for (int y = 0; y < m_size; y++) {
-			m_tiles[x][y]->draw(w);
-		}
+	if (m_isBatchDirty) {
+		buildVertices();
+		m_isBatchDirty = false;
 	}
+
+	w->draw(m_quads);
+	w->draw(m_faces, RenderStates(&m_atlas->getTexture()));
 }
 
 /**
@@ -713,10 +538,10 @@ void Grid::__toString()
 {
 	std::cout << std::endl << "-------------- DISPLAYING THE GRID" << std::endl << std::endl;
 
-	for (int x = 0; x < m_size; x++) {
-		for (int y = 0; y < m_size; y++) {
-			m_tiles[x][y]->__toString();
-		}
+	m_game->getBoard().__toString();
+
+	for (size_t i = 0; i < m_tiles.size(); i++) {
+		m_tiles[i].__toString();
 	}
 
 	std::cout << "-------------- END OF DISPLAYING" << std::endl;
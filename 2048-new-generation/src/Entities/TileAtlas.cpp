@@ -0,0 +1,249 @@
+#include "pch.h"
+#include "Constants.h"
+#include "Core/Board.h"
+#include "Entities/TileAtlas.h"
+#include "Entities/Quad.h"
+
+#include <algorithm>
+#include <string>
+
+// Slots : one face per exponent and per text colour, on few enough columns to keep the texture small on big screens
+static const int ATLAS_FACES = MAX_EXPONENT + 1;
+static const int ATLAS_SLOTS = 2 * ATLAS_FACES;
+static const int ATLAS_COLUMNS = 8;
+static const int ATLAS_ROWS = ATLAS_SLOTS / ATLAS_COLUMNS;
+
+/**
+	@param font The font the numbers are written with, its digits already rasterized at TEXT_ATLAS_SIZE
+	@param tileSize The size of a face, in pixels
+*/
+TileAtlas::TileAtlas(const Font* font, unsigned int tileSize)
+{
+	m_font = font;
+	m_tileSize = tileSize;
+	m_texture = nullptr;
+	m_isRendered = std::vector<bool>(ATLAS_SLOTS, false);
+}
+
+TileAtlas::~TileAtlas()
+{
+	delete m_texture;
+}
+
+/**
+	Get the background colour of a tile
+
+	@param value The tile value, GHOST_VAL for an empty cell
+	@return The colour
+*/
+Color TileAtlas::getFaceColor(int value)
+{
+	switch (value) {
+		case 2:
+			return TILE_COLOR_2;
+		case 4:
+			return TILE_COLOR_4;
+		case 8:
+			return TILE_COLOR_8;
+		case 16:
+			return TILE_COLOR_16;
+		case 32:
+			return TILE_COLOR_32;
+		case 64:
+			return TILE_COLOR_64;
+		case 128:
+			return TILE_COLOR_128;
+		case 256:
+			return TILE_COLOR_256;
+		case 512:
+			return TILE_COLOR_512;
+		case 1024:
+			return TILE_COLOR_1024;
+		case 2048:
+			return TILE_COLOR_2048;
+	}
+
+	// 4096 and beyond
+	if (value > 2048) {
+		return TILE_COLOR_BEYOND;
+	}
+
+	return TILE_COLOR_GHOST;
+}
+
+/**
+	Get the character size of a tile's number
+
+	@param value The tile value, GHOST_VAL for an empty cell
+	@return The character size
+*/
+unsigned int TileAtlas::getTextSize(int value)
+{
+	// 16384, 32768
+	if (value > 8192) {
+		return TEXT_SIZE_5DIGIT;
+	}
+
+	// 1024, 2048, 4096, 8192
+	if (value > 512) {
+		return TEXT_SIZE_4DIGIT;
+	}
+
+	// 128, 256, 512
+	if (value > 64) {
+		return TEXT_SIZE_3DIGIT;
+	}
+
+	if (value == GHOST_VAL) {
+		return TEXT_SIZE_GHOST;
+	}
+
+	// 2, 4, 16, 32, 64
+	return TEXT_SIZE_STD;
+}
+
+/**
+	Get the face of a tile, rendering it first if it has never been asked for
+
+	@param value The tile value, GHOST_VAL for an empty cell
+	@param isNewlyCreated If the number is highlighted as newly created
+	@return The texture coordinates of the face
+*/
+FloatRect TileAtlas::getFace(int value, bool isNewlyCreated)
+{
+	int slot = getSlot(value, isNewlyCreated);
+
+	if (!m_isRendered[slot]) {
+		renderFace(slot, value, isNewlyCreated);
+		m_isRendered[slot] = true;
+	}
+
+	return getSlotRect(slot);
+}
+
+int TileAtlas::getSlot(int value, bool isNewlyCreated)
+{
+	return (isNewlyCreated ? ATLAS_FACES : 0) + Board::toExponent(value);
+}
+
+FloatRect TileAtlas::getSlotRect(int slot)
+{
+	return FloatRect(
+		(float)((slot % ATLAS_COLUMNS) * m_tileSize),
+		(float)((slot / ATLAS_COLUMNS) * m_tileSize),
+		(float)m_tileSize,
+		(float)m_tileSize
+	);
+}
+
+/**
+	Render a face into its slot of the atlas
+
+	@param slot The slot of the face
+	@param value The tile value, GHOST_VAL for an empty cell
+	@param isNewlyCreated If the number is highlighted as newly created
+*/
+void TileAtlas::renderFace(int slot, int value, bool isNewlyCreated)
+{
+	if (!m_texture) {
+		m_texture = new RenderTexture();
+		m_texture->create(ATLAS_COLUMNS * m_tileSize, ATLAS_ROWS * m_tileSize);
+		m_texture->setSmooth(true);
+		m_texture->clear(Color::Transparent);
+	}
+
+	FloatRect rect = getSlotRect(slot);
+	VertexArray background(Quads);
+	VertexArray glyphs(Quads);
+
+	appendQuad(background, rect, getFaceColor(value));
+	layoutText(glyphs, value, isNewlyCreated, rect);
+
+	m_texture->draw(background);
+	m_texture->draw(glyphs, RenderStates(&m_font->getTexture(TEXT_ATLAS_SIZE)));
+	m_texture->display();
+}
+
+/**
+	Lay a number out as glyph quads centered on a face, the same way a centered sf::Text would be
+	Glyphs all come from the atlas size and are scaled down to the number's text size
+
+	@param glyphs Where to add the glyph quads
+	@param value The tile value, GHOST_VAL for an empty cell
+	@param isNewlyCreated If the number is highlighted as newly created
+	@param rect The face to center the number on
+*/
+void TileAtlas::layoutText(VertexArray& glyphs, int value, bool isNewlyCreated, const FloatRect& rect)
+{
+	if (value == GHOST_VAL) {
+		return;
+	}
+
+	std::string text = std::to_string(value);
+	Color color = isNewlyCreated ? Color::Red : Color::White;
+	float scale = (float)getTextSize(value) / TEXT_ATLAS_SIZE;
+	float penX = 0.0f;
+	float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+
+	// Glyph quads relative to the start of the baseline, in atlas pixels
+	for (size_t i = 0; i < text.size(); i++) {
+		const Glyph& glyph = m_font->getGlyph(text[i], TEXT_ATLAS_SIZE, false);
+		FloatRect quad(
+			penX + glyph.bounds.left,
+			TEXT_ATLAS_SIZE + glyph.bounds.top,
+			glyph.bounds.width,
+			glyph.bounds.height
+		);
+		FloatRect texRect(
+			(float)glyph.textureRect.left,
+			(float)glyph.textureRect.top,
+			(float)glyph.textureRect.width,
+			(float)glyph.textureRect.height
+		);
+
+		if (i == 0) {
+			minX = quad.left;
+			minY = quad.top;
+			maxX = quad.left + quad.width;
+			maxY = quad.top + quad.height;
+		}
+		else {
+			minX = std::min(minX, quad.left);
+			minY = std::min(minY, quad.top);
+			maxX = std::max(maxX, quad.left + quad.width);
+			maxY = std::max(maxY, quad.top + quad.height);
+		}
+
+		appendQuad(glyphs, quad, color, texRect);
+		penX += glyph.advance;
+	}
+
+	// Scale the text down then center it on the face
+	float offsetX = rect.left + (rect.width / 2.0f) - ((maxX - minX) * scale / 2.0f) - (minX * scale / 2.0f);
+	float offsetY = rect.top + (rect.height / 2.0f) - ((maxY - minY) * scale / 2.0f) - (minY * scale / 2.0f);
+
+	for (size_t i = 0; i < glyphs.getVertexCount(); i++) {
+		glyphs[i].position.x = offsetX + glyphs[i].position.x * scale;
+		glyphs[i].position.y = offsetY + glyphs[i].position.y * scale;
+	}
+}
+
+/**
+	Get the texture holding every rendered face
+
+	@return The texture
+*/
+const Texture& TileAtlas::getTexture()
+{
+	// Nothing has been rendered yet, make sure there is a texture to bind
+	if (!m_texture) {
+		getFace(GHOST_VAL, false);
+	}
+
+	return m_texture->getTexture();
+}
+
+unsigned int TileAtlas::getTileSize()
+{
+	return m_tileSize;
+}
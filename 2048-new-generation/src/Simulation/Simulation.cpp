@@ -0,0 +1,334 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "Core/Game.h"
+#include "Core/Random.h"
+#include "Core/ThreadPool.h"
+#include "AI/AI_Hard.h"
+#include "AI/AI_Normal.h"
+#include "AI/HeuristicEvaluator.h"
+#include "AI/NTupleNetwork.h"
+#include "Simulation/Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+
+/**
+	Get the score below which the provided share of the sorted scores lie (nearest rank)
+
+	@param sorted The scores, in ascending order
+	@param percent The share, between 0 and 100
+	@return The percentile
+*/
+static int getPercentile(const std::vector<int>& sorted, int percent)
+{
+	size_t rank = (sorted.size() * percent + 99) / 100;
+
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+	@param level AI_EASY, AI_NORMAL or AI_HARD
+	@param gameCount The number of games to play
+	@param threadCount The number of games played at once (0 for every hardware thread)
+	@param seed The master seed every game's seed is derived from
+*/
+Simulation::Simulation(int level, int gameCount, int threadCount, uint64_t seed)
+{
+	m_level = level;
+	m_gameCount = gameCount;
+	m_threadCount = threadCount;
+	m_seed = seed;
+	m_moveLimit = 0;
+	m_timeBudget = 0;
+	m_evaluator = nullptr;
+	m_seconds = 0.0;
+}
+
+Simulation::~Simulation()
+{
+	delete m_evaluator;
+}
+
+/**
+	Convert an AI name from the command line into its level
+
+	@param name "easy", "normal", "hard" or the level number
+	@return The level, AI_HARD if the name is unknown
+*/
+int Simulation::parseLevel(const std::string& name)
+{
+	if (name == "easy" || name == "0") {
+		return AI_EASY;
+	}
+
+	if (name == "normal" || name == "1") {
+		return AI_NORMAL;
+	}
+
+	return AI_HARD;
+}
+
+/**
+	Derive the seed of a game from the master seed (splitmix64)
+	Seeds only depend on the game index so results do not depend on the threads scheduling
+
+	@param seed The master seed
+	@param index The index of the game
+	@return The seed of the game
+*/
+uint64_t Simulation::getGameSeed(uint64_t seed, int index)
+{
+	uint64_t state = seed + 0x9E3779B97F4A7C15ULL * (uint64_t)index;
+
+	return Random::splitMix(state);
+}
+
+/**
+	Play --games games with the --ai AI (easy, normal or hard) on --threads threads (0 for every hardware thread)
+	from --seed, a fresh one without it, and print the results
+	Games stop after --moves moves if given, the AI searches each move for --budget milliseconds if given
+	and otherwise always searches its whole depth, so the same --seed gives the same results
+	The AI evaluates the boards with the n-tuple network of --weights or the heuristic weighted by --heuristic if given
+	Shared by the simulation executable and the game's --headless mode
+
+	@param options The command line options
+	@return The exit code of the process, 1 if an evaluator could not be loaded
+*/
+int Simulation::runFromOptions(const Options& options)
+{
+	Simulation simulation(
+		parseLevel(options.getString("ai", "hard")),
+		options.getInt("games", 100),
+		options.getInt("threads", 0),
+		options.getUInt64("seed", Random::createSeed())
+	);
+
+	if (options.has("weights") && !simulation.loadWeights(options.getString("weights", ""))) {
+		return 1;
+	}
+
+	if (options.has("heuristic") && !simulation.loadHeuristic(options.getString("heuristic", ""))) {
+		return 1;
+	}
+
+	simulation.setMoveLimit(options.getInt("moves", 0));
+	simulation.setTimeBudget(options.getInt("budget", 0));
+	simulation.run();
+	simulation.report();
+
+	return 0;
+}
+
+/**
+	Evaluate the boards of every game with an n-tuple network, mapped once for all the games
+
+	@param path The weights of the network, trained for the grid of the AI
+	@return If the weights have been loaded
+*/
+bool Simulation::loadWeights(const std::string& path)
+{
+	NTupleNetwork* network = new NTupleNetwork(AI::getLevelGridSize(m_level));
+
+	if (!network->load(path)) {
+		std::cout << "Cannot load " << path << " : " << network->getLoadError() << std::endl;
+		delete network;
+		return false;
+	}
+
+	delete m_evaluator;
+	m_evaluator = network;
+
+	return true;
+}
+
+/**
+	Evaluate the boards of every game with the heuristic, built once for all the games
+
+	@param path The config file of the weights of the heuristic
+	@return If the weights have been loaded
+*/
+bool Simulation::loadHeuristic(const std::string& path)
+{
+	HeuristicEvaluator::Weights weights;
+	std::string error;
+
+	if (!HeuristicEvaluator::loadWeights(path, &weights, &error)) {
+		std::cout << "Cannot load " << path << " : " << error << std::endl;
+		return false;
+	}
+
+	delete m_evaluator;
+	m_evaluator = new HeuristicEvaluator(AI::getLevelGridSize(m_level), weights);
+
+	return true;
+}
+
+/**
+	Play every game across the thread pool, each task writing only its own result
+*/
+void Simulation::run()
+{
+	ThreadPool pool(m_threadCount);
+
+	m_threadCount = pool.getThreadCount();
+	m_results = std::vector<GameResult>(m_gameCount);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	pool.parallelFor(m_gameCount, [this](int i) {
+		m_results[i] = playGame(i);
+	});
+
+	m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+	Play a single game until no move is possible or the move limit is reached
+	The game has its own AI, searching on a single thread since the pool is already busy with other games,
+	so without time budget the same seed always gives the same game
+
+	@param index The index of the game
+	@return The result of the game
+*/
+Simulation::GameResult Simulation::playGame(int index)
+{
+	AI* ai = AI::create(m_level, 1, m_timeBudget);
+	Game game(ai->getGridSize(), getGameSeed(m_seed, index));
+
+	if (m_evaluator) {
+		ai->setEvaluator(m_evaluator);
+	}
+
+	game.start();
+
+	while (game.isMovePossible() && (m_moveLimit == 0 || game.getMoveCount() < m_moveLimit)) {
+		int dir = ai->chooseMove(game.getBoard());
+
+		if (dir == DIR_NONE || !game.play(dir)) {
+			break;
+		}
+	}
+
+	GameResult result;
+	result.score = game.getScore();
+	result.maxTile = game.getMaxTile();
+	result.moveCount = game.getMoveCount();
+	result.tableHits = 0;
+	result.tableProbes = 0;
+	result.tableCollisions = 0;
+	result.playoutCount = 0;
+	result.playoutMoveCount = 0;
+
+	AI_Hard* hard = dynamic_cast<AI_Hard*>(ai);
+
+	if (hard) {
+		TranspositionTable* table = hard->getTable();
+
+		result.tableHits = table->getHits();
+		result.tableProbes = table->getHits() + table->getMisses();
+		result.tableCollisions = table->getCollisions();
+	}
+
+	AI_Normal* normal = dynamic_cast<AI_Normal*>(ai);
+
+	if (normal) {
+		result.playoutCount = normal->getSearch()->getTotalPlayoutCount();
+		result.playoutMoveCount = normal->getSearch()->getTotalMoveCount();
+	}
+
+	delete ai;
+
+	return result;
+}
+
+/**
+	Print the score distribution, the max tile histogram and the speed of the last run
+*/
+void Simulation::report()
+{
+	if (m_results.empty()) {
+		std::cout << "No game played" << std::endl;
+		return;
+	}
+
+	// Merge the results of every game
+	std::vector<int> sorted(m_results.size());
+	std::map<int, int> histogram;
+	long long total = 0;
+	long long moveCount = 0;
+	long long tableHits = 0;
+	long long tableProbes = 0;
+	long long tableCollisions = 0;
+	long long playoutCount = 0;
+	long long playoutMoveCount = 0;
+
+	for (size_t i = 0; i < m_results.size(); i++) {
+		sorted[i] = m_results[i].score;
+		++histogram[m_results[i].maxTile];
+		total += m_results[i].score;
+		moveCount += m_results[i].moveCount;
+		tableHits += m_results[i].tableHits;
+		tableProbes += m_results[i].tableProbes;
+		tableCollisions += m_results[i].tableCollisions;
+		playoutCount += m_results[i].playoutCount;
+		playoutMoveCount += m_results[i].playoutMoveCount;
+	}
+
+	std::sort(sorted.begin(), sorted.end());
+
+	std::cout << "Games : " << sorted.size() << " on " << m_threadCount << " threads, seed " << m_seed << std::endl;
+	std::cout << "Score : min " << sorted.front()
+		<< ", mean " << total / (long long)sorted.size()
+		<< ", p10 " << getPercentile(sorted, 10)
+		<< ", median " << getPercentile(sorted, 50)
+		<< ", p90 " << getPercentile(sorted, 90)
+		<< ", p99 " << getPercentile(sorted, 99)
+		<< ", max " << sorted.back() << std::endl;
+
+	std::cout << "Max tile :" << std::endl;
+
+	for (std::map<int, int>::const_iterator it = histogram.begin(); it != histogram.end(); ++it) {
+		std::cout << "\t" << it->first << "\t" << it->second
+			<< "\t(" << 100.0 * it->second / m_results.size() << "%)" << std::endl;
+	}
+
+	if (tableProbes > 0) {
+		std::cout << "Transposition table : " << tableHits << " hits / " << tableProbes << " probes, "
+			<< tableCollisions << " collisions" << std::endl;
+	}
+
+	double seconds = m_seconds > 0.0 ? m_seconds : 1e-9;
+
+	if (playoutCount > 0) {
+		std::cout << "Playouts : " << playoutCount << " playouts, "
+			<< playoutMoveCount << " random moves, "
+			<< playoutMoveCount / seconds << " random moves/s" << std::endl;
+	}
+
+	std::cout << "Time : " << m_seconds << " s, "
+		<< m_results.size() / seconds << " games/s, "
+		<< moveCount / seconds << " moves/s" << std::endl;
+}
+
+/**
+	Stop every game after a number of moves, so a run with a slow AI stays short
+
+	@param moveLimit The number of moves per game, 0 to play until no move is possible
+*/
+void Simulation::setMoveLimit(int moveLimit)
+{
+	m_moveLimit = moveLimit;
+}
+
+/**
+	Bound the search of the AI on each move by the clock, as in the window
+	The depth reached then depends on the load of the machine, so runs of the same seed may differ
+
+	@param timeBudget The time per move in milliseconds, 0 to always search the whole depth
+*/
+void Simulation::setTimeBudget(int timeBudget)
+{
+	m_timeBudget = timeBudget;
+}
@@ -0,0 +1,15 @@
+#include "pch.h"
+#include "Core/Options.h"
+#include "Simulation/Simulation.h"
+
+/**
+	Play the games the options describe and print the results (see Simulation::runFromOptions),
+	without linking any window or graphics library
+	Same as the game's --headless mode, for the machines the simulations are deployed on
+*/
+int main(int argc, char** argv)
+{
+	Options options(argc, argv);
+
+	return Simulation::runFromOptions(options);
+}
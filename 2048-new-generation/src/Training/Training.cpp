@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "Core/GameConstants.h"
+#include "Simulation/Simulation.h"
+#include "Training/Training.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+/**
+	@param network The network to train, made writable if it is not yet
+	@param rate The learning rate of a whole board
+	@param lambda The weight of the later rewards in the returns, 0 for TD(0)
+	@param seed The master seed every game's seed is derived from
+*/
+Training::Training(NTupleNetwork* network, float rate, float lambda, uint64_t seed)
+{
+	m_network = network;
+	m_rate = rate;
+	m_lambda = lambda;
+	m_seed = seed;
+
+	m_network->makeWritable();
+}
+
+/**
+	Play and learn games, printing the progress and saving the weights every few games
+
+	@param gameCount The number of games to play
+	@param reportInterval The number of games between two reports
+	@param output The path to save the weights to
+*/
+void Training::run(int gameCount, int reportInterval, const std::string& output)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	long long scoreSum = 0;
+	long long moveCount = 0;
+	int maxScore = 0;
+	int winCount = 0;
+	int played = 0;
+
+	reportInterval = std::max(reportInterval, 1);
+
+	for (int i = 0; i < gameCount; i++) {
+		Game game(m_network->getSize(), Simulation::getGameSeed(m_seed, i));
+
+		playGame(game);
+		learnGame();
+
+		scoreSum += game.getScore();
+		moveCount += game.getMoveCount();
+		maxScore = std::max(maxScore, game.getScore());
+		winCount += game.getMaxTile() >= 2048 ? 1 : 0;
+		++played;
+
+		if (played < reportInterval && i < gameCount - 1) {
+			continue;
+		}
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "Games " << i + 1 << " : mean " << scoreSum / played
+			<< ", max " << maxScore
+			<< ", 2048 " << 100.0 * winCount / played << "%, "
+			<< moveCount / (seconds > 0.0 ? seconds : 1e-9) << " moves/s" << std::endl;
+
+		if (!m_network->save(output)) {
+			std::cout << "Cannot write " << output << std::endl;
+		}
+
+		start = std::chrono::steady_clock::now();
+		scoreSum = 0;
+		moveCount = 0;
+		maxScore = 0;
+		winCount = 0;
+		played = 0;
+	}
+}
+
+/**
+	Play a whole game with the current weights, keeping the board after each move for the learning
+
+	@param game The game, not started yet
+*/
+void Training::playGame(Game& game)
+{
+	m_afterstates.clear();
+	m_rewards.clear();
+
+	game.start();
+
+	while (game.isMovePossible()) {
+		int score = game.getScore();
+
+		game.move(chooseMove(game.getBoard()));
+
+		m_afterstates.push_back(game.getBoard());
+		m_rewards.push_back(game.getScore() - score);
+
+		game.spawnTile();
+	}
+}
+
+/**
+	Move the value of each board of the last game towards its lambda-return, from the end of the game
+	Going backwards, each return is built from the values the later boards have just learned
+
+	The board after the last move has no future so its return is 0
+*/
+void Training::learnGame()
+{
+	float step = m_rate / m_network->getLookupCount();
+	float target = 0.0f;
+
+	for (int i = (int)m_afterstates.size() - 1; i >= 0; i--) {
+		const Board& board = m_afterstates[i];
+
+		m_network->update(board, step * (target - m_network->evaluate(board)));
+
+		target = m_rewards[i] + (1.0f - m_lambda) * m_network->evaluate(board) + m_lambda * target;
+	}
+}
+
+/**
+	Pick the move with the best score plus value of the board it leads to
+
+	@param board The current state of the game
+	@return The chosen direction, DIR_NONE if no move is possible
+*/
+int Training::chooseMove(const Board& board)
+{
+	int bestDir = DIR_NONE;
+	float bestValue = 0.0f;
+
+	for (int dir = 0; dir < DIR_COUNT; dir++) {
+		Board next = board;
+		int score = 0;
+
+		if (!next.move(dir, &score)) {
+			continue;
+		}
+
+		float value = score + m_network->evaluate(next);
+
+		if (bestDir == DIR_NONE || value > bestValue) {
+			bestDir = dir;
+			bestValue = value;
+		}
+	}
+
+	return bestDir;
+}
@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "AI/NTupleNetwork.h"
+#include "Core/GameConstants.h"
+#include "Core/Options.h"
+#include "Core/Random.h"
+#include "Training/Training.h"
+
+#include <iostream>
+
+/**
+	Train the n-tuple network of a --size grid (3 to 5) over --games games of self-play and save it to --output
+	every --report games, the learning going on from the weights of --input if given
+	The learning rate is --rate and the returns are weighted by --lambda (0 for TD(0))
+*/
+int main(int argc, char** argv)
+{
+	Options options(argc, argv);
+	int size = options.getInt("size", SIZE_AI_NORMAL);
+
+	if (size < GRID_SIZE_MIN || size > GRID_SIZE_MAX) {
+		std::cout << "Invalid size " << size << " : from " << GRID_SIZE_MIN << " to " << GRID_SIZE_MAX << " expected" << std::endl;
+		return 1;
+	}
+
+	NTupleNetwork network(size);
+
+	if (options.has("input") && !network.load(options.getString("input", ""))) {
+		std::cout << "Cannot load " << options.getString("input", "") << " : " << network.getLoadError() << std::endl;
+		return 1;
+	}
+
+	uint64_t seed = options.getUInt64("seed", Random::createSeed());
+
+	std::cout << "Training " << size << "x" << size << ", " << network.getWeightCount() << " weights, seed " << seed << std::endl;
+
+	Training training(
+		&network,
+		options.getFloat("rate", 0.1f),
+		options.getFloat("lambda", 0.0f),
+		seed
+	);
+
+	training.run(
+		options.getInt("games", 100000),
+		options.getInt("report", 1000),
+		options.getString("output", "weights-" + std::to_string(size) + ".bin")
+	);
+
+	return 0;
+}
@@ -1,10 +1,42 @@
 #include "pch.h"
 #include "Engine/Engine.h"
+#include "Constants.h"
+#include "Core/Options.h"
+#include "Core/Random.h"
+#include "Simulation/Simulation.h"
 
-int main()
+#include <iostream>
+
+/**
+	Start the game in a window, or with --headless play the games the options describe and print the results
+	(see Simulation::runFromOptions)
+	In the window the AI's heuristic is weighted by --heuristic, assets/config/heuristic.cfg by default
+	Without --seed a fresh seed is drawn, --verbose prints it so the session can be replayed
+	The window's main loop is paced by --loop (fixed, vsync or event) and capped to --fps frames per second,
+	moves take --anim milliseconds on screen
+*/
+int main(int argc, char** argv)
 {
-	Engine engine;
+	Options options(argc, argv);
+
+	if (options.has("headless")) {
+		return Simulation::runFromOptions(options);
+	}
+
+	uint64_t seed = options.getUInt64("seed", Random::createSeed());
+
+	if (options.has("verbose")) {
+		std::cout << "Seed : " << seed << std::endl;
+	}
+
+	Engine engine(
+		seed,
+		Engine::parseLoopPolicy(options.getString("loop", "fixed")),
+		(unsigned int)options.getInt("fps", LOOP_FRAMERATE),
+		options.getInt("anim", ANIMATION_DURATION),
+		options.getString("heuristic", HEURISTIC_CONFIG_PATH)
+	);
 	engine.start();
 
 	return 0;
-}
\ No newline at end of file
+}